@@ -0,0 +1,327 @@
+//! @file
+//! @brief Match3 engine benchmarks, results are written as JSON.
+//! @details usage: Match3_bench [--quick] [--warmup N] [--repetitions N]
+//! [--filter NAME] [--output FILE] [--baseline FILE] [--threshold RATIO]
+//! [--budget-ms MS] [--latency-budget-us US]
+//!
+//! Each operation is run across board sizes and type counts, a size is skipped
+//! (as well as the larger ones) when a single run exceeds the time budget.
+//!
+//! The latency of Game::play() on a 9x9 board is also sampled over many turns,
+//! the run fails if its p99 exceeds the latency budget (if any).
+//! addItems and assign load a full board (items are created by the setup of
+//! addItems, by the body of assign).
+//! The replay benchmark re-simulates a recorded 9x9 game of 50 moves.
+#include <Bench.hpp>
+#include <Match3/Board.hpp>
+#include <Match3/Game.hpp>
+#include <Match3/Replay.hpp>
+#include <Match3/Types.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace match3;
+
+namespace {
+
+//! @brief Runs a benchmark if a single probe run fits in the budget.
+//! @return false if the probe run is over budget.
+bool
+measure(
+  bench::Runner& runner,
+  const std::string& name,
+  std::size_t ops,
+  const std::function<void()>& setup,
+  const std::function<void()>& body,
+  std::chrono::milliseconds budget) {
+	if (!runner.selected(name)) return true;
+	setup();
+	const bench::Clock::time_point before = bench::Clock::now();
+	body();
+	if (bench::Clock::now() - before > budget) {
+		runner.skip(name, "over budget");
+		return false;
+	}
+	runner.run(name, ops, setup, body);
+	return true;
+}
+
+std::string
+label(const std::string& op, const Size& size, std::size_t types = 0) {
+	std::string res = op + "/" + std::to_string(size.x()) + "x" + std::to_string(size.y());
+	if (types) res += "/t" + std::to_string(types);
+	return res;
+}
+
+TypesPtr
+makeTypes(std::size_t count) {
+	TypesPtr types = std::make_shared<Types>();
+	for (std::size_t i = 0; i < count; ++i) {
+		types->addTypes({Type("t" + std::to_string(i))});
+	}
+	return types;
+}
+
+//! @brief Removes matches and settles the board until it is stable (no refill).
+std::size_t
+resolveTurn(Board& board) {
+	std::size_t removed = 0;
+	for (std::vector<ItemPtr> items = board.findandRemoveMatches(); !items.empty();
+	     items                      = board.findandRemoveMatches()) {
+		removed += items.size();
+		while (!board.iterate().empty()) {
+		}
+	}
+	return removed;
+}
+
+//! @brief Gets the next move to play, starts a new board on deadlock.
+Move
+nextMove(Game& game) {
+	std::optional<Move> move = game.board()->findMove();
+	while (!move) {
+		game.fillBoard();
+		move = game.board()->findMove();
+	}
+	return *move;
+}
+
+//! @brief Times turns one by one.
+//! @return The p99 latency of a turn in nanoseconds.
+double
+playLatency(Game& game, std::size_t turns) {
+	std::vector<double> samples;
+	samples.reserve(turns);
+	for (std::size_t i = 0; i < turns; ++i) {
+		const Move move                       = nextMove(game);
+		const bench::Clock::time_point before = bench::Clock::now();
+		bench::doNotOptimize(game.play(move));
+		const bench::Clock::time_point after = bench::Clock::now();
+		samples.push_back(
+		  double(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count()));
+	}
+	std::sort(samples.begin(), samples.end());
+	// nearest-rank percentile
+	return samples[std::min(
+	  samples.size() - 1, std::size_t(std::ceil(0.99 * double(samples.size()))) - 1)];
+}
+
+//! @brief Sweeps one operation over board sizes, stops at the first size over budget.
+void
+sweep(
+  bench::Runner& runner,
+  const std::string& op,
+  const std::vector<Size>& sizes,
+  std::size_t types,
+  const std::function<std::size_t(const Size&)>& ops,
+  const std::function<void(const Size&)>& setup,
+  const std::function<void(const Size&)>& body,
+  std::chrono::milliseconds budget) {
+	bool overBudget = false;
+	for (const Size& size : sizes) {
+		const std::string name = label(op, size, types);
+		if (overBudget) {
+			runner.skip(name, "smaller size over budget");
+			continue;
+		}
+		overBudget = !measure(
+		  runner, name, ops(size), [&]() { setup(size); }, [&]() { body(size); }, budget);
+	}
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+	bench::Runner runner("Match3", bench::Options::parse(argc, argv));
+	const bool quick                  = runner.options().quick;
+	std::chrono::milliseconds budget(quick ? 100 : 250);
+	// No latency budget by default, the figures depend on the machine.
+	double latencyBudget                  = 0.;
+	const std::vector<std::string>& extra = runner.options().extra;
+	for (std::size_t i = 0; i + 1 < extra.size(); ++i) {
+		if (extra[i] == "--budget-ms") budget = std::chrono::milliseconds(std::stol(extra[i + 1]));
+		if (extra[i] == "--latency-budget-us") latencyBudget = std::stod(extra[i + 1]) * 1000.;
+	}
+
+	std::vector<Size> sizes;
+	for (std::size_t n : {6, 9, 16, 32, 64, 128, 256, 512}) {
+		if (quick && n > 9) break;
+		sizes.push_back(Size(n, n));
+	}
+	std::vector<std::size_t> typeCounts = {3, 4, 5, 6, 7, 8};
+	if (quick) typeCounts = {3, 8};
+
+	std::mt19937 gen(42);
+	TypesPtr types;
+	BoardPtr board;
+	auto one = [](const Size&) { return std::size_t(1); };
+
+	// Size only dependent operations.
+	types = makeTypes(typeCounts.front());
+	board = std::make_shared<Board>(types);
+	sweep(
+	  runner, "resize", sizes, 0, one, [&](const Size&) { board->resize({0, 0}); },
+	  [&](const Size& size) { board->resize(size); }, budget);
+
+	std::vector<Position> positions;
+	constexpr std::size_t lookups = 256;
+	sweep(
+	  runner, "item", sizes, 0, [](const Size&) { return lookups; },
+	  [&](const Size& size) {
+		  if (board->size() != size) {
+			  board->resize(size);
+			  board->fill();
+		  }
+		  std::uniform_int_distribution<int> x(0, int(size.x()) - 1);
+		  std::uniform_int_distribution<int> y(0, int(size.y()) - 1);
+		  positions.clear();
+		  for (std::size_t i = 0; i < lookups; ++i) {
+			  positions.push_back(Position(x(gen), y(gen)));
+		  }
+	  },
+	  [&](const Size&) {
+		  for (const Position& pos : positions) {
+			  bench::doNotOptimize(board->item(pos));
+		  }
+	  },
+	  budget);
+
+	// Bulk loads of a full board, e.g. a level.
+	std::vector<ItemPtr> items;
+	sweep(
+	  runner, "addItems", sizes, 0, one,
+	  [&](const Size& size) {
+		  if (board->size() != size) board->resize(size);
+		  board->clear();
+		  items.clear();
+		  for (std::size_t j = 0; j < size.y(); ++j) {
+			  for (std::size_t i = 0; i < size.x(); ++i) {
+				  items.push_back(std::make_shared<Item>(types->palette()[(i + j) % types->size()],
+				                                         Position(int(i), int(j))));
+			  }
+		  }
+	  },
+	  [&](const Size&) { board->addItems(items); }, budget);
+	items.clear();
+	std::vector<TypeId> ids;
+	sweep(
+	  runner, "assign", sizes, 0, one,
+	  [&](const Size& size) {
+		  ids.resize(size.x() * size.y());
+		  for (std::size_t i = 0; i < ids.size(); ++i) {
+			  ids[i] = TypeId(Type::FirstId + i % types->size());
+		  }
+	  },
+	  [&](const Size& size) { board->assign(ids, size); }, budget);
+
+	// Type count dependent operations.
+	for (std::size_t typeCount : typeCounts) {
+		types = makeTypes(typeCount);
+		board = std::make_shared<Board>(types);
+		auto resized = [&](const Size& size) {
+			if (board->size() != size) board->resize(size);
+		};
+
+		sweep(
+		  runner, "fill", sizes, typeCount, one, resized, [&](const Size&) { board->fill(); }, budget);
+		sweep(
+		  runner, "getMatches", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  resized(size);
+			  board->fill();
+		  },
+		  [&](const Size&) { bench::doNotOptimize(board->getMatches()); }, budget);
+		sweep(
+		  runner, "moveCount", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  resized(size);
+			  board->fill(true);
+		  },
+		  [&](const Size&) { bench::doNotOptimize(board->moveCount()); }, budget);
+		sweep(
+		  runner, "findandRemoveMatches", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  resized(size);
+			  board->fill();
+		  },
+		  [&](const Size&) { bench::doNotOptimize(board->findandRemoveMatches()); }, budget);
+		sweep(
+		  runner, "iterate", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  resized(size);
+			  board->fill();
+			  board->findandRemoveMatches();
+		  },
+		  [&](const Size&) { bench::doNotOptimize(board->iterate()); }, budget);
+		sweep(
+		  runner, "turn", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  resized(size);
+			  board->fill();
+		  },
+		  [&](const Size&) { bench::doNotOptimize(resolveTurn(*board)); }, budget);
+
+		// Full turns (swap, cascade, refill, deadlock check) on a stable board.
+		std::unique_ptr<Game> game = std::make_unique<Game>();
+		game->setTypes(*types);
+		Move move;
+		sweep(
+		  runner, "play", sizes, typeCount, one,
+		  [&](const Size& size) {
+			  if (game->size() != size) {
+				  game->resize(size);
+				  game->fillBoard();
+			  }
+			  move = nextMove(*game);
+		  },
+		  [&](const Size&) { bench::doNotOptimize(game->play(move)); }, budget);
+	}
+
+	// Replay of a recorded game.
+	for (std::size_t typeCount : typeCounts) {
+		const Size size(9, 9);
+		const std::string name = label("replay", size, typeCount);
+		if (!runner.selected(name)) continue;
+		Game game(size);
+		game.setTypes(*makeTypes(typeCount));
+		game.fillBoard(42);
+		ReplayRecorder recorder(game);
+		for (std::size_t i = 0; i < 50; ++i) {
+			const std::optional<Move> move = game.board()->findMove();
+			if (!move) break;
+			game.play(*move);
+		}
+		const std::vector<std::byte> replay = recorder.data();
+		ReplayPlayer player;
+		runner.run(name, 1, [&]() { bench::doNotOptimize(player.run(replay)); });
+	}
+
+	// Turn latency on the reference board size.
+	bool overLatency = false;
+	for (std::size_t typeCount : typeCounts) {
+		const Size size(9, 9);
+		const std::string name = label("play-p99", size, typeCount);
+		if (!runner.selected(name)) continue;
+		Game game(size);
+		game.setTypes(*makeTypes(typeCount));
+		game.fillBoard();
+		const double p99 = playLatency(game, quick ? 1000 : 10000);
+		runner.metric(name, p99, "ns");
+		if (latencyBudget > 0. && p99 > latencyBudget) {
+			std::cerr << name << " over the latency budget: " << p99 << " ns > " << latencyBudget
+			          << " ns" << std::endl;
+			overLatency = true;
+		}
+	}
+	const int status = runner.report();
+	return overLatency ? EXIT_FAILURE : status;
+}
@@ -1,13 +1,21 @@
 //! @file
 #pragma once
 
+#include "BoardDelta.hpp"
 #include "Cell.hpp"
 #include "Item.hpp"
+#include "Move.hpp"
+#include "Random.hpp"
 #include "Size.hpp"
 #include "Types.hpp"
+#include <Signal/Signal.hpp>
+#include <chrono>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <ostream>
-#include <unordered_set>
+#include <span>
+#include <unordered_map>
 
 namespace match3 {
 class Cell;
@@ -21,7 +29,12 @@ using ConstItemPtr = std::shared_ptr<const Item>;
  * @details
  * - by default item fall from up to bottom
  * - by default swap is possible only if this move generates match.
- * - Position {0, 0} (i.e. origin) is at the @b bottom left @b of the Grid.*/
+ * - Position {0, 0} (i.e. origin) is at the @b bottom left @b of the Grid.
+ * - Each operation emits a single @ref BoardDelta on @ref changed.
+ * - Cells and items are indexed by position, thus lookups are O(1).
+ * - Cells can be blocked to give the board any shape (see @ref mask).
+ * @warning Item positions must only be changed through the Board (e.g. @ref swap),
+ * setting Item::position directly leaves the index out of date.*/
 class Board : public std::enable_shared_from_this<Board> {
 	public:
 	//! @brief Build an empty Board.
@@ -32,17 +45,21 @@ class Board : public std::enable_shared_from_this<Board> {
 	//! @brief Destructs the object.
 	~Board() = default;
 
-	//! @brief Constructs an object with the copy of the content of other.
-	Board(const Board&) = default;
-	//! @brief Replaces the contents with a copy of the contents of other.
-	//! @return *this.
-	Board& operator=(const Board&) = default;
+	Board(const Board&) = delete;            // no cpyable
+	Board& operator=(const Board&) = delete; // no cpy op
 	//! @brief Constructs an object with the contents of other using move semantics.
 	Board(Board&&) = default;
 	//! @brief Replaces the contents with those of other using move semantics.
 	//! @return *this.
 	Board& operator=(Board&&) = default;
 
+	/*! @brief Signal emitted once per operation with all the changes done.
+	 * @details Observers get the whole operation in packed arrays, thus there is
+	 * no need to connect to each @ref Item or @ref Cell property.
+	 * Nothing is recorded while there is no observer.
+	 * @note Changes done directly on Item or Cell properties are not reported.*/
+	mutable Signal::Signal<BoardDelta> changed;
+
 	//! @brief Clear the board by removing all items.
 	void clear();
 
@@ -51,10 +68,14 @@ class Board : public std::enable_shared_from_this<Board> {
 	const Size& size() const noexcept;
 	/*! @brief Resize the board to the specified size.
 	 * @details All @ref Cell and @ref Item will be remove.
-	 * then new cells will be created to fill the new dimension.
+	 * then new cells will be created to fill the new dimension, all playable.
 	 * @param[in] size The new size requested.*/
 	void resize(Size size);
 
+	//! @brief Gets the Types used to fill the board.
+	//! @return The Types, empty pointer if they are destroyed.
+	ConstTypesPtr types() const noexcept;
+
 	/*! @brief Return all @ref Cell "Cells" in the board.
 	 * @return List of @ref Cell "Cell(s)" pointer.*/
 	std::vector<ConstCellPtr> cells() const;
@@ -68,6 +89,27 @@ class Board : public std::enable_shared_from_this<Board> {
 	//! @copydoc cell(const Position&) const.
 	CellPtr cell(const Position& pos);
 
+	/*! @brief Checks if a cell can hold an item.
+	 * @details A blocked cell never holds an item, thus it breaks runs and
+	 * can't be swapped, and items slide diagonally around it (see @ref FallPaths).
+	 * @param[in] pos Position of the cell.
+	 * @return false if the cell is blocked or outside the board.*/
+	bool playable(const Position& pos) const noexcept;
+	/*! @brief Blocks or unblocks a cell.
+	 * @param[in] pos Position of the cell, ignored if outside the board.
+	 * @param[in] playable false to block the cell, its item is removed.*/
+	void setPlayable(const Position& pos, bool playable);
+	/*! @brief Gets the shape of the board.
+	 * @return One bit per cell, row major (see @ref BoardDelta::index) from
+	 * the least significant bit of the first word, set if the cell is
+	 * playable. Bits past the last cell are zero.*/
+	std::span<const std::uint64_t> mask() const noexcept;
+	/*! @brief Replaces the shape of the board.
+	 * @param[in] mask See @ref mask, empty to make all cells playable.
+	 * @throw std::runtime_error if mask doesn't match the board size.
+	 * @post Items of the cells blocked are removed.*/
+	void setMask(std::span<const std::uint64_t> mask);
+
 	/*! @brief Returns all @ref Item "Items" in the board.
 	 * @return List of @ref Item "item(s)" pointer.*/
 	std::vector<ConstItemPtr> items() const;
@@ -83,13 +125,36 @@ class Board : public std::enable_shared_from_this<Board> {
 	//! @brief Adds a new item to the board.
 	//! @param[in] item The new item to add.
 	//! @throw std::runtime_error if there is already an Item at the position
-	//! specified by the Item.
+	//! specified by the Item or if this position is outside the board or
+	//! blocked.
 	void addItem(ItemPtr item);
 	//! @brief Adds several @ref Item "items" to the board.
+	//! @details Positions are checked before any item is added, so the board
+	//! is left unchanged on error.
 	//! @param[in] items The new items to add.
 	//! @throw std::runtime_error if there is already an Item at the position
-	//! specified by the Item.
+	//! specified by the Item or if this position is outside the board or
+	//! blocked.
 	void addItems(const std::vector<ItemPtr>& items);
+	/*! @brief Replaces all items (and cell types) from TypeId buffers.
+	 * @details The board is resized if needed, then each item is created in a
+	 * single pass over the buffers, e.g. to load a level.
+	 * @param[in] items Row major item TypeIds (see @ref BoardDelta::index),
+	 * Type::NoneId for an empty cell.
+	 * @param[in] size Size of the board.
+	 * @param[in] cells Row major cell TypeIds, empty to reset all cells to
+	 * Type::None.
+	 * @param[in] mask Shape of the board (see @ref mask), empty to make all
+	 * cells playable.
+	 * @throw std::runtime_error if a buffer doesn't match the size or an item
+	 * is in a blocked cell.
+	 * @throw std::out_of_range if a TypeId is not in the palette, the board is
+	 * left unchanged.*/
+	void assign(
+	  std::span<const TypeId> items,
+	  const Size& size,
+	  std::span<const TypeId> cells       = {},
+	  std::span<const std::uint64_t> mask = {});
 
 	//! @brief Removes @ref Item at position specified from board.
 	//! @param[in] pos Position of the item to remove.
@@ -108,6 +173,19 @@ class Board : public std::enable_shared_from_this<Board> {
 	//! @return The list of removed items.
 	std::vector<ItemPtr> removeItems(const std::vector<ConstItemPtr>& items);
 
+	//! @brief Swaps two adjacent items.
+	//! @details The swap is kept only if it creates at least one match.
+	//! @param[in] lhs Position of the first item.
+	//! @param[in] rhs Position of the second item.
+	//! @return true if items have been swapped, false otherwise (i.e.
+	//! positions are not adjacent, a cell is empty or there is no match).
+	bool swap(const Position& lhs, const Position& rhs);
+	//! @brief Changes the type of an item in place.
+	//! @param[in] pos Position of the item.
+	//! @param[in] type The new Type.
+	//! @return The Item modified if any.
+	ItemPtr setItemType(const Position& pos, const Type& type);
+
 	//! @brief Lists of available gravity direction.
 	enum class Gravity { Up, Down, Left, Right, None };
 	//! @brief Get current gravity direction use to move Item.
@@ -115,12 +193,96 @@ class Board : public std::enable_shared_from_this<Board> {
 	Gravity gravity() const noexcept;
 	//! @brief Updates the Gravity direction use to move Item.
 	//! @param[in] gravity The Gravity direction requested.
-	void setGravity(const Gravity& gravity) noexcept;
+	void setGravity(const Gravity& gravity);
+
+	/*! @brief Fall paths of a board shape for a gravity direction.
+	 * @details Each playable cell is fed by its upper neighbour (against the
+	 * gravity), or if this one is blocked by the upper neighbour in the
+	 * previous or the next lane (columns for Up and Down, rows for Left and
+	 * Right): items slide diagonally around blocked cells. Cells fed by no
+	 * other cell (on the source side, or below a blocked cell without playable
+	 * diagonal) receive the new items.
+	 *
+	 * The cells fed from a same source form a lane, each cell listed after the
+	 * cells it feeds, thus from the floor to the source. Built once per shape
+	 * and direction, the settle steps only walk these tables.*/
+	class FallPaths {
+		public:
+		//! @brief Marks a cell which is not in a lane.
+		static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+		//! @brief Builds the paths of an empty board.
+		FallPaths();
+		/*! @brief Builds the paths of a board shape.
+		 * @param[in] size Size of the board.
+		 * @param[in] mask Shape of the board, see @ref Board::mask.
+		 * @param[in] gravity Gravity direction, no lane for Gravity::None.*/
+		FallPaths(const Size& size, std::span<const std::uint64_t> mask, Gravity gravity);
+
+		//! @brief Gets the gravity direction.
+		Gravity gravity() const noexcept;
+		//! @brief Gets the number of lanes.
+		std::size_t laneCount() const noexcept;
+		//! @brief Gets the cells of a lane, each one after the cells it feeds:
+		//! the straight one first, then the diagonal ones in lane order.
+		//! @param[in] lane Lane index, less than @ref laneCount.
+		std::span<const std::uint32_t> lane(std::size_t lane) const noexcept;
+		//! @brief Gets the lane of a cell.
+		//! @return The lane index, npos if the cell is blocked.
+		std::uint32_t laneOf(std::size_t index) const noexcept;
+		//! @brief Gets the rank of a cell in its lane, 0 on the floor.
+		//! @return The rank, npos if the cell is blocked.
+		std::uint32_t rankOf(std::size_t index) const noexcept;
+		//! @brief Gets the cell feeding a cell.
+		//! @return The upper neighbour of the cell, or the diagonal one if it
+		//! is blocked, npos if the cell is a source or is blocked.
+		std::uint32_t feeder(std::size_t index) const noexcept;
+		//! @brief Gets the lower neighbour of a cell in its column (or row).
+		//! @return npos if the cell is on the floor, or if one of them is
+		//! blocked.
+		std::uint32_t below(std::size_t index) const noexcept;
+		//! @brief Gets the cells with a feeder in the order of a settle step:
+		//! from the floor, the cells fed straight first in each rank.
+		std::span<const std::uint32_t> order() const noexcept;
+
+		protected:
+		//! @brief Stores the gravity direction.
+		Gravity _gravity;
+		//! @brief Stores the cells of all lanes, lane after lane.
+		std::vector<std::uint32_t> _cells;
+		//! @brief Stores the first entry of each lane in _cells, plus the end.
+		std::vector<std::uint32_t> _starts;
+		//! @brief Stores the entry of each cell in _cells, npos if blocked.
+		std::vector<std::uint32_t> _entries;
+		//! @brief Stores the lane of each entry of _cells.
+		std::vector<std::uint32_t> _lanes;
+		//! @brief Stores the feeder of each cell, npos if none.
+		std::vector<std::uint32_t> _feeders;
+		//! @brief Stores the lower neighbour of each cell, npos if none.
+		std::vector<std::uint32_t> _below;
+		//! @brief Stores the cells with a feeder in settle order.
+		std::vector<std::uint32_t> _order;
+	};
+	//! @brief Gets the fall paths of the current shape and gravity.
+	//! @return The paths, rebuilt when the shape or the gravity changes.
+	const FallPaths& fallPaths() const noexcept;
+
+	//! @brief Gets the generator used to create new items.
+	//! @details Seeded from std::random_device by default, seed it to get a
+	//! reproducible board.
+	//! @return The generator.
+	Random& random() noexcept;
+	//! @copydoc random()
+	const Random& random() const noexcept;
 
 	//! @brief Fills board with items
 	//! @note @ref Type::Any and @ref Type::None are not use for filling board.
 	//! @note all previous items will be removed.
-	void fill();
+	//! @param[in] stable true to re-roll the items of the initial matches so
+	//! the board starts without match, in the same @ref BoardDelta.
+	//! @throw std::runtime_error if Types are empty, or if stable is requested
+	//! with less than 2 types.
+	void fill(bool stable = false);
 
 	//! @brief Checks if item at position specified can form a match.
 	//! @param[in] pos The Position requested.
@@ -142,8 +304,71 @@ class Board : public std::enable_shared_from_this<Board> {
 	//! @return List of items removed from the board.
 	std::vector<ItemPtr> findandRemoveMatches();
 	//! @brief Find and move items which can fall.
+	//! @details Each empty cell takes the item of its feeder (see
+	//! @ref FallPaths), thus items move by one cell at most.
 	//! @return List of items whose position has changed.
+	//! @throw std::runtime_error if gravity is None.
 	std::vector<ItemPtr> iterate();
+	//! @brief Time spent in each phase of a @ref cascade.
+	struct CascadeProfile {
+		//! @brief Finding and removing matches.
+		std::chrono::nanoseconds match{0};
+		//! @brief Letting items fall.
+		std::chrono::nanoseconds settle{0};
+		//! @brief Adding new items (@ref resolve only).
+		std::chrono::nanoseconds refill{0};
+		//! @brief Number of match and settle rounds.
+		std::size_t rounds = 0;
+	};
+	//! @brief Removes matches and lets items fall until the board is stable.
+	//! @details All steps are reported as a single @ref BoardDelta.
+	//! @param[out] profile If not null, receives the time spent in each phase
+	//! (the clock is not read otherwise).
+	//! @return List of items removed from the board.
+	std::vector<ItemPtr> cascade(CascadeProfile* profile = nullptr);
+
+	//! @brief Outcome of a @ref resolve.
+	struct Resolution {
+		//! @brief Number of items removed.
+		std::size_t removed = 0;
+		//! @brief Number of items added by the refill.
+		std::size_t added = 0;
+		//! @brief Number of match and settle rounds.
+		std::size_t rounds = 0;
+	};
+	/*! @brief Removes the matches created around some cells, lets items fall,
+	 * then optionally refills the board, until it is stable.
+	 * @details Unlike @ref cascade, only the cells which changed are checked:
+	 * the seeds first, then the items moved or added by the previous round.
+	 * Thus the cost depends on the number of affected cells, not on the board
+	 * size. All steps are reported as a single @ref BoardDelta.
+	 * @pre The board was stable (i.e. without match) except around the seeds.
+	 * @param[in] seeds Positions which changed (e.g. the two cells of a swap),
+	 * positions outside the board are ignored.
+	 * @param[in] refill true to add random items in the cells left empty.
+	 * @param[out] profile If not null, receives the time spent in each phase
+	 * (the clock is not read otherwise).
+	 * @return The number of items removed and added.
+	 * @throw std::runtime_error if gravity is None, if refill is requested
+	 * with less than 2 types, or if the board is still not stable after 1000
+	 * rounds.*/
+	Resolution resolve(
+	  std::span<const Position> seeds, bool refill, CascadeProfile* profile = nullptr);
+
+	//! @brief Finds a swap creating a match.
+	//! @details Swaps are evaluated without changing the board, the search
+	//! stops at the first move found.
+	//! @return The first move found (scanning rows from the bottom), nothing if
+	//! the board is deadlocked.
+	std::optional<Move> findMove() const noexcept;
+	//! @brief Checks if a swap can create a match.
+	//! @return false if the board is deadlocked.
+	bool hasMove() const noexcept;
+	//! @brief Counts the swaps creating a match.
+	//! @param[in] limit The count stops once it reaches limit.
+	//! @return The number of legal moves, at most limit.
+	std::size_t moveCount(
+	  std::size_t limit = std::numeric_limits<std::size_t>::max()) const noexcept;
 
 	//! @brief Stream operator for debug purpose.
 	//! @param[in,out] os Stream to write.
@@ -156,13 +381,96 @@ class Board : public std::enable_shared_from_this<Board> {
 	ConstTypesWkPtr _types;
 	//! @brief Stores the current size of the board.
 	Size _size;
-	//! @brief Stores each tile in the board.
-	std::unordered_set<CellPtr> _cells;
-	//! @brief Stores each item in the board.
-	std::unordered_set<ItemPtr> _items;
+	//! @brief Stores each tile in the board, row major (see @ref BoardDelta::index).
+	std::vector<CellPtr> _cells;
+	//! @brief Stores the item of each cell, row major, empty pointer if none.
+	std::vector<ItemPtr> _items;
+	//! @brief Stores the shape of the board, see @ref mask.
+	std::vector<std::uint64_t> _mask;
+	//! @brief Number of items in the board.
+	std::size_t _itemCount;
+	//! @brief Generator used to create new items.
+	Random _random;
+	//! @brief Scratch marks of @ref resolve, one per cell.
+	std::vector<std::uint32_t> _marks;
+	//! @brief Last mark used.
+	std::uint32_t _mark;
+	//! @brief Scratch feeders of @ref resolve, skipping the empty cells.
+	std::vector<std::uint32_t> _skips;
+	//! @brief Scratch origins of the items moved by @ref resolve, npos if
+	//! none.
+	std::vector<std::uint32_t> _origins;
+	//! @brief Scratch match codes of @ref resolve, the mark of their round in
+	//! the high half.
+	std::vector<std::uint64_t> _codes;
 
 	//! @brief Stores gravity direction, by default item fall down.
 	enum Gravity _gravity;
+	//! @brief Stores the fall paths of the shape and gravity.
+	FallPaths _fallPaths;
+
+	//! @brief Groups changes of nested operations into a single delta.
+	class _Batch;
+	//! @brief State of an item before the current operation.
+	struct _Track {
+		//! @brief Cell index before the operation.
+		std::uint32_t origin;
+		//! @brief Type identifier before the operation.
+		TypeId type;
+		//! @brief Item has been added by the operation.
+		bool added;
+	};
+	//! @brief Number of nested operations in progress.
+	std::size_t _batchDepth;
+	//! @brief Operation in progress is recorded (i.e. changed has observers).
+	bool _recording;
+	//! @brief Types used to compute identifiers while recording.
+	ConstTypesPtr _recordTypes;
+	//! @brief Items touched by the operation in progress.
+	std::unordered_map<const Item*, _Track> _tracks;
+	//! @brief Delta being built, reused to avoid allocations.
+	BoardDelta _delta;
+
+	//! @brief Starts an operation, nested operations are merged in the outer one.
+	//! @param[in] operation The operation starting.
+	void _beginBatch(BoardDelta::Operation operation);
+	//! @brief Ends an operation, the outer one emits the delta.
+	//! @param[in] commit false to drop the changes (e.g. on exception).
+	void _endBatch(bool commit);
+	//! @brief Records an item before it moves or changes type.
+	//! @param[in] item The item about to change.
+	void _touch(const Item& item);
+	//! @brief Records an item added to the board.
+	//! @param[in] item The new item.
+	void _touchAdded(const Item& item);
+	//! @brief Records an item before it leaves the board.
+	//! @param[in] item The item about to be removed.
+	void _touchRemoved(const Item& item);
+
+	//! @brief Checks if a position is inside the board.
+	bool _contains(const Position& pos) const noexcept;
+	//! @brief Gets the row major index of a position inside the board.
+	std::size_t _index(const Position& pos) const noexcept;
+	//! @brief Checks if a cell is playable, see @ref playable.
+	//! @param[in] index Index of a cell inside the board.
+	bool _playable(std::size_t index) const noexcept;
+	//! @brief Replaces the shape, removing the items of the cells blocked.
+	//! @param[in] mask See @ref setMask, its size must be checked.
+	void _setMask(std::span<const std::uint64_t> mask);
+	//! @brief Gets a new mark value for @ref _marks.
+	std::uint32_t _nextMark();
+	//! @brief Creates an item in an empty cell.
+	//! @param[in] index Index of the cell.
+	//! @param[in] type The Type of the item.
+	void _spawn(std::size_t index, const Type& type);
+	//! @brief Resolves matches around cells, see @ref resolve.
+	//! @param[in,out] candidates Cell indexes to check, used as scratch.
+	Resolution _resolve(
+	  std::vector<std::uint32_t>& candidates, bool refill, CascadeProfile* profile);
+	//! @brief Calls visit with each swap creating a match, in the order of
+	//! @ref findMove, until it returns false.
+	template <typename Visitor>
+	void _visitMoves(Visitor&& visit) const noexcept;
 
 	//! @brief Checks if item at position specified can form a match along X axis.
 	//! @param[in] pos The Position to check.
@@ -0,0 +1,131 @@
+//! @file
+#pragma once
+
+#include "Position.hpp"
+#include "Size.hpp"
+#include "Type.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Changes applied to a @ref Board by one operation.
+ * @details Cells are identified by their row major index
+ * (i.e. `y * size.x() + x`).
+ * The delta describes the transition from the board before the operation to
+ * the board after it, intermediate steps (e.g. an item falling several times
+ * during a cascade) are merged, thus it can be applied in this order:
+ * -# remove items listed in @ref removed (cells before the operation),
+ * -# move items listed in @ref moved,
+ * -# create items listed in @ref added (cells after the operation),
+ * -# update types listed in @ref retyped (cells after the operation).
+ *
+ * Each list is sorted by cell index.*/
+struct BoardDelta {
+	//! @brief Lists of operations reported by a delta.
+	enum class Operation : std::uint8_t {
+		//! @brief Board has been resized, all items and cells are replaced.
+		Resize,
+		//! @brief All items have been removed.
+		Clear,
+		//! @brief Board has been filled with new items.
+		Fill,
+		//! @brief Items have been added.
+		Add,
+		//! @brief Items have been removed.
+		Removal,
+		//! @brief Items have fallen.
+		Settle,
+		//! @brief Two items have been swapped.
+		Swap,
+		//! @brief Items have been changed in place.
+		Retype,
+		//! @brief Matches have been removed and items have fallen until the
+		//! board is stable.
+		Cascade,
+		//! @brief All items have been replaced from a buffer.
+		Assign,
+		//! @brief Cells have been blocked or unblocked, the items of the
+		//! cells blocked have been removed.
+		Shape
+	};
+
+	//! @brief An item created or destroyed.
+	struct Entry {
+		//! @brief Cell index of the item.
+		std::uint32_t cell;
+		//! @brief Type identifier of the item.
+		TypeId type;
+	};
+	//! @brief An item which has changed of cell.
+	struct Move {
+		//! @brief Cell index before the operation.
+		std::uint32_t from;
+		//! @brief Cell index after the operation.
+		std::uint32_t to;
+		//! @brief Type identifier of the item before the operation.
+		TypeId type;
+	};
+	//! @brief An item whose type has changed.
+	struct Retype {
+		//! @brief Cell index of the item after the operation.
+		std::uint32_t cell;
+		//! @brief Type identifier before the operation.
+		TypeId from;
+		//! @brief Type identifier after the operation.
+		TypeId to;
+	};
+
+	//! @brief Operation which has produced this delta.
+	Operation operation = Operation::Clear;
+	//! @brief Size of the board after the operation.
+	Size size = {0, 0};
+	//! @brief Items created by the operation.
+	std::vector<Entry> added;
+	//! @brief Items destroyed by the operation.
+	std::vector<Entry> removed;
+	//! @brief Items which have changed of cell.
+	std::vector<Move> moved;
+	//! @brief Items whose type has changed.
+	std::vector<Retype> retyped;
+
+	//! @brief Gets the cell index of a position.
+	//! @param[in] pos Position in the board.
+	//! @return The row major index.
+	std::uint32_t index(const Position& pos) const noexcept {
+		return std::uint32_t(pos.y()) * std::uint32_t(size.x()) + std::uint32_t(pos.x());
+	}
+	//! @brief Gets the position of a cell index.
+	//! @param[in] index Row major index.
+	//! @return The position in the board.
+	Position position(std::uint32_t index) const noexcept {
+		return Position(int(index % size.x()), int(index / size.x()));
+	}
+
+	//! @brief Checks if the operation changed nothing.
+	//! @return true if all lists are empty.
+	bool empty() const noexcept {
+		return added.empty() && removed.empty() && moved.empty() && retyped.empty();
+	}
+	//! @brief Removes all entries.
+	//! @note Capacity is kept so the delta can be reused without allocation.
+	void clear() noexcept {
+		added.clear();
+		removed.clear();
+		moved.clear();
+		retyped.clear();
+	}
+
+	//! @brief Stream operator for debug purpose.
+	//! @param[in,out] os Stream to write.
+	//! @param[in] obj BoardDelta instance to log.
+	//! @return the output stream.
+	friend std::ostream& operator<<(std::ostream& os, const BoardDelta& obj) {
+		os << "{operation: " << int(obj.operation) << ", size: " << obj.size
+		   << ", added: " << obj.added.size() << ", removed: " << obj.removed.size()
+		   << ", moved: " << obj.moved.size() << ", retyped: " << obj.retyped.size() << "}";
+		return os;
+	}
+};
+} // namespace match3
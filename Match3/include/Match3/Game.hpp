@@ -2,7 +2,11 @@
 #pragma once
 
 #include "Board.hpp"
+#include "Move.hpp"
 #include "Types.hpp"
+#include <Signal/Signal.hpp>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <unordered_set>
 
@@ -15,9 +19,42 @@ class Game {
 	//! @param[in] size Size of the board.
 	explicit Game(Size size = {0, 0});
 
+	//! @brief Signal emitted with the new score each time it changes.
+	mutable Signal::Signal<std::size_t> scoreChanged;
+	//! @brief Signal emitted with the new number of moves each time it changes.
+	mutable Signal::Signal<std::size_t> movesChanged;
+	//! @brief Signal emitted with each valid move, once the turn is resolved.
+	mutable Signal::Signal<Move> played;
+
 	//! @brief Gets current score.
 	//! @return Current score.
 	std::size_t score() const noexcept;
+	//! @brief Gets the number of moves played.
+	//! @return Number of valid @ref play since the last clear.
+	std::size_t moves() const noexcept;
+
+	//! @brief Engine statistics of a move.
+	struct TurnStats {
+		//! @brief Time spent swapping (including the match check).
+		std::chrono::nanoseconds swap{0};
+		//! @brief Time spent finding and removing matches.
+		std::chrono::nanoseconds match{0};
+		//! @brief Time spent letting items fall.
+		std::chrono::nanoseconds settle{0};
+		//! @brief Time spent adding new items.
+		std::chrono::nanoseconds refill{0};
+		//! @brief Time spent checking for a remaining move.
+		std::chrono::nanoseconds deadlock{0};
+		//! @brief Number of items removed.
+		std::size_t removed = 0;
+		//! @brief Number of items added.
+		std::size_t added = 0;
+		//! @brief Number of match and settle rounds.
+		std::size_t rounds = 0;
+	};
+	//! @brief Gets the statistics of the last move played.
+	//! @return Statistics of the last valid @ref play, all zero if none.
+	const TurnStats& lastTurn() const noexcept;
 
 	//! @brief Gets the underlying Board object.
 	//! @return The @ref Board instance.
@@ -32,13 +69,13 @@ class Game {
 	const Size& size() const noexcept;
 	//! @brief Resizes the Board to the specified dimension.
 	//! @param[in] size THe new size requested.
-	//! @note The score is reset to zero.
+	//! @note The score and moves are reset to zero.
 	//! @note This method clear the Board from previous items.
 	//! @note This method clear the Board from previous cells.
 	void resize(const Size& size);
 
 	//! @brief Clears the board.
-	//! @post The score is set to zero.
+	//! @post The score and moves are set to zero.
 	//! @post All items are removed.
 	void clear() noexcept;
 	//! @brief Resets the board.
@@ -52,17 +89,76 @@ class Game {
 	//! @post All items are removed.
 	//! @post All previous Types are removed.
 	//! @param[in] types The new Types requested.
+	//! @throw std::runtime_error if there are less than 2 types.
 	void setTypes(const Types& types);
-	//! @brief Fills the board with new items.
+	//! @brief Fills the board with new items, using a random seed.
 	//! @note First Game is cleared.
+	//! @post The board has no match.
 	void fillBoard();
+	/*! @brief Fills the board with new items.
+	 * @details The board and all the items added by the following turns only
+	 * depend on the seed, the size, the types and the moves played, thus a
+	 * game can be replayed.
+	 * @param[in] seed Seed of the board generator.
+	 * @note First Game is cleared.
+	 * @post The board has no match.*/
+	void fillBoard(std::uint64_t seed);
+	//! @brief Gets the seed of the last @ref fillBoard.
+	//! @return The seed, 0 if the board has never been filled.
+	std::uint64_t seed() const noexcept;
+
+	/*! @brief Computes a digest of the game state.
+	 * @details Covers the board (size, gravity, shape, cell and item TypeIds
+	 * and generator state) and the score, whatever the number of types.
+	 * Intended to compare two runs of a game, it is not a cryptographic hash.
+	 * @return 64 bits FNV-1a hash of the state.*/
+	std::uint64_t hash() const noexcept;
+
+	//! @brief Outcome of a @ref play.
+	struct TurnResult {
+		//! @brief Number of items removed.
+		std::uint32_t removed = 0;
+		//! @brief Number of items added by the refill.
+		std::uint32_t added = 0;
+		//! @brief Number of match and settle rounds.
+		std::uint32_t rounds = 0;
+		//! @brief Points scored.
+		std::uint32_t points = 0;
+		//! @brief The move has been played.
+		bool valid = false;
+		//! @brief No move is left on the board.
+		bool deadlock = false;
+	};
+	/*! @brief Plays a turn.
+	 * @details Swaps the two items (the move is rejected if it creates no
+	 * match, see @ref Board::swap), resolves the cascade around the swapped
+	 * cells refilling the board (see @ref Board::resolve), updates the score
+	 * then checks for deadlock. Each stage only looks at the cells affected,
+	 * except the deadlock check which stops at the first move found.
+	 * @param[in] move The move to play.
+	 * @return The outcome of the turn, only valid is set if the move is rejected.
+	 * @post The score is increased by the number of items removed.
+	 * @post @ref lastTurn is updated.
+	 * @note On deadlock the board is left as is, e.g. call @ref fillBoard.*/
+	TurnResult play(const Move& move);
 
 	protected:
 	//! @brief Stores score.
 	std::size_t _score;
+	//! @brief Stores number of moves played.
+	std::size_t _moves;
+	//! @brief Stores seed of the last fill.
+	std::uint64_t _seed;
+	//! @brief Stores statistics of the last move.
+	TurnStats _lastTurn;
 	//! @brief Stores list of Types currently in use.
 	std::shared_ptr<Types> _types;
 	//! @brief Stores Board instance.
 	std::shared_ptr<Board> _board;
+
+	//! @brief Updates the score and emits @ref scoreChanged if it differs.
+	void _setScore(std::size_t score);
+	//! @brief Updates the moves and emits @ref movesChanged if they differ.
+	void _setMoves(std::size_t moves);
 };
 } // namespace match3
@@ -0,0 +1,105 @@
+//! @file
+#pragma once
+
+#include "LevelPack.hpp"
+#include "Size.hpp"
+#include "Types.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Generates starting boards satisfying some constraints.
+ * @details Each attempt fills a board with @ref Board::fill (removing the
+ * initial matches), then the board is kept only if it passes every
+ * @ref Constraints check.
+ *
+ * Attempts are shared among worker threads through an atomic counter, each
+ * worker owns its board and writes the boards kept to its own buffer, so
+ * workers never wait for each other. The generator of attempt N is seeded
+ * from the seed and N, and the boards kept are those of the first attempts,
+ * thus the output only depends on the seed, not on the number of threads.*/
+class Generator {
+	public:
+	//! @brief Constraints a board must satisfy to be kept.
+	struct Constraints {
+		//! @brief Minimum number of legal moves (see @ref Board::moveCount).
+		std::size_t minMoves = 1;
+		//! @brief Maximum number of legal moves.
+		std::size_t maxMoves = std::numeric_limits<std::size_t>::max();
+		/*! @brief Target share of each palette type, in palette order (they
+		 * don't need to sum to one), empty to accept any distribution.*/
+		std::vector<double> distribution;
+		//! @brief Largest difference allowed between the share of a type and
+		//! its target.
+		double tolerance = 0.05;
+	};
+
+	//! @brief Counters of a @ref run.
+	struct Stats {
+		//! @brief Number of boards generated.
+		std::uint64_t attempts = 0;
+		//! @brief Number of boards passing all constraints.
+		std::uint64_t accepted = 0;
+		//! @brief Boards rejected because the stable fill gave up (see
+		//! @ref Board::fill).
+		std::uint64_t fillRejected = 0;
+		//! @brief Boards rejected because of their type distribution.
+		std::uint64_t distributionRejected = 0;
+		//! @brief Boards rejected because of their legal move count.
+		std::uint64_t moveRejected = 0;
+		//! @brief Wall time of the run.
+		std::chrono::nanoseconds elapsed{0};
+
+		//! @brief Gets the number of boards generated per second.
+		double boardsPerSecond() const noexcept;
+	};
+
+	/*! @brief Builds a generator keeping any board with a legal move.
+	 * @param[in] types Types used to fill the boards.
+	 * @param[in] size Size of the boards.
+	 * @throw std::runtime_error if there are less than 2 types.*/
+	Generator(const Types& types, const Size& size);
+	/*! @brief Builds a generator.
+	 * @param[in] types Types used to fill the boards.
+	 * @param[in] size Size of the boards.
+	 * @param[in] constraints Constraints of the boards kept.
+	 * @throw std::runtime_error if there are less than 2 types, or if the distribution
+	 * doesn't have one non negative share per type.*/
+	Generator(const Types& types, const Size& size, Constraints constraints);
+
+	Generator(const Generator&) = delete;            // no cpyable
+	Generator& operator=(const Generator&) = delete; // no cpy op
+
+	//! @brief Gets the constraints.
+	const Constraints& constraints() const noexcept;
+
+	/*! @brief Generates boards.
+	 * @param[in] count Number of boards to keep.
+	 * @param[in] seed Seed of the run.
+	 * @param[out] out Pack receiving the boards kept, in attempt order.
+	 * @param[in] threads Number of worker threads, 0 for one per hardware
+	 * thread.
+	 * @param[in] maxAttempts Number of attempts after which the run gives up,
+	 * 0 for 1000 attempts per board.
+	 * @return The counters of the run, accepted is less than count if the run
+	 * gave up.*/
+	Stats run(
+	  std::size_t count,
+	  std::uint64_t seed,
+	  LevelPackWriter& out,
+	  std::size_t threads       = 0,
+	  std::uint64_t maxAttempts = 0) const;
+
+	protected:
+	//! @brief Stores the types used to fill the boards.
+	TypesPtr _types;
+	//! @brief Stores the size of the boards.
+	Size _size;
+	//! @brief Stores the constraints.
+	Constraints _constraints;
+};
+} // namespace match3
@@ -0,0 +1,193 @@
+//! @file
+#pragma once
+
+#include "Board.hpp"
+#include "PackedBoard.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Read-only collection of levels mapped from a file.
+ * @details The file is memory mapped and each level is a @ref PackedBoard
+ * view on the mapping, so opening a pack doesn't read nor copy the levels and
+ * the pages of a level are only loaded when it is accessed.
+ *
+ * Layout (version 1, integers are little endian):
+ * | Offset   | Size          | Content                                        |
+ * |----------|---------------|------------------------------------------------|
+ * | 0        | 4             | magic `M3LP`                                   |
+ * | 4        | 4             | version                                        |
+ * | 8        | 8             | number of levels N                             |
+ * | 16       | 8 * (N + 1)   | offset of each level from the start of the     |
+ * |          |               | file, then the end of the last level           |
+ * | 24 + 8 N |               | levels, serialized by @ref PackedBoard::pack   |
+ *
+ * Views stay valid as long as the pack is alive.*/
+class LevelPack {
+	public:
+	//! @brief Version of the layout written by @ref LevelPackWriter.
+	static constexpr std::uint32_t Version = 1;
+	//! @brief Size of the header in bytes, without the offsets.
+	static constexpr std::size_t HeaderSize = 16;
+
+	/*! @brief Maps a pack.
+	 * @param[in] path Path of the pack file.
+	 * @throw std::runtime_error if the file can't be mapped or is not a pack of
+	 * a known version.*/
+	explicit LevelPack(const std::string& path);
+	//! @brief Unmaps the pack.
+	~LevelPack();
+
+	LevelPack(const LevelPack&) = delete;            // no cpyable
+	LevelPack& operator=(const LevelPack&) = delete; // no cpy op
+
+	//! @brief Gets the number of levels.
+	std::size_t size() const noexcept;
+	//! @brief Gets the bytes of the file.
+	std::span<const std::byte> data() const noexcept;
+
+	/*! @brief Gets a level.
+	 * @param[in] index Index of the level.
+	 * @return A view of the level.
+	 * @throw std::out_of_range if index is not less than @ref size.
+	 * @throw std::runtime_error if the level is corrupted.*/
+	PackedBoard level(std::size_t index) const;
+
+	//! @brief Iterates over the levels in file order.
+	class Iterator {
+		public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = PackedBoard;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = void;
+		using reference         = PackedBoard;
+
+		Iterator() = default;
+		Iterator(const LevelPack* pack, std::size_t index) noexcept
+		  : _pack(pack)
+		  , _index(index) {}
+
+		PackedBoard operator*() const { return _pack->level(_index); }
+		Iterator& operator++() noexcept {
+			++_index;
+			return *this;
+		}
+		Iterator operator++(int) noexcept {
+			Iterator res = *this;
+			++_index;
+			return res;
+		}
+		bool operator==(const Iterator& rhs) const noexcept { return _index == rhs._index; }
+		bool operator!=(const Iterator& rhs) const noexcept { return _index != rhs._index; }
+
+		private:
+		const LevelPack* _pack = nullptr;
+		std::size_t _index     = 0;
+	};
+	//! @brief Gets an iterator to the first level.
+	Iterator begin() const noexcept;
+	//! @brief Gets the end iterator.
+	Iterator end() const noexcept;
+
+	/*! @brief Hands out levels to worker threads.
+	 * @details Each level is returned once, whatever the number of threads
+	 * calling @ref next, without any lock:
+	 * @code
+	 * LevelPack::Cursor cursor(pack);
+	 * // In each worker:
+	 * while (std::optional<std::size_t> index = cursor.next()) {
+	 *   const PackedBoard level = pack.level(*index);
+	 *   ...
+	 * }
+	 * @endcode*/
+	class Cursor {
+		public:
+		//! @brief Starts at the first level of a pack which must outlive the cursor.
+		explicit Cursor(const LevelPack& pack) noexcept;
+
+		Cursor(const Cursor&) = delete;            // no cpyable
+		Cursor& operator=(const Cursor&) = delete; // no cpy op
+
+		//! @brief Claims the next level.
+		//! @return Its index, std::nullopt once all levels are claimed.
+		std::optional<std::size_t> next() noexcept;
+
+		protected:
+		//! @brief Stores the number of levels.
+		const std::size_t _size;
+		//! @brief Stores the index of the next level.
+		std::atomic<std::size_t> _next;
+	};
+
+	protected:
+	//! @brief Reads the offset of a level.
+	std::uint64_t _offset(std::size_t index) const noexcept;
+
+	//! @brief Stores the mapped bytes.
+	std::span<const std::byte> _data;
+	//! @brief Stores the number of levels.
+	std::size_t _size;
+#ifdef _WIN32
+	//! @brief Stores the file mapping handle.
+	void* _mapping;
+#endif
+};
+
+/*! @brief Builds a level pack.
+ * @details Levels are kept in memory until @ref write.*/
+class LevelPackWriter {
+	public:
+	//! @brief Builds an empty pack.
+	LevelPackWriter();
+
+	//! @brief Adds a level.
+	//! @param[in] board The board, see @ref PackedBoard::pack.
+	void add(const Board& board);
+	/*! @brief Adds a serialized level.
+	 * @param[in] level The level, see @ref PackedBoard::pack.
+	 * @throw std::runtime_error if level is not a valid packed board.*/
+	void add(std::span<const std::byte> level);
+
+	/*! @brief Adds the levels of a text grid.
+	 * @details Levels are separated by blank lines, each line is a row of the
+	 * board starting from the top (the row of highest y). A `.` is an empty
+	 * cell, a `X` a blocked cell (see @ref Board::playable) and letters `a` to
+	 * `n` are the types of the palette in order (i.e. TypeId Type::FirstId to
+	 * 15). Lines starting with `#` are comments.
+	 * @code
+	 * # 3x3 level
+	 * abc
+	 * bXa
+	 * .ab
+	 * @endcode
+	 * @param[in,out] in The text to read.
+	 * @return The number of levels added.
+	 * @throw std::runtime_error with the line number if a row doesn't have the
+	 * size of the first row or contains an unknown character.*/
+	std::size_t addText(std::istream& in);
+
+	//! @brief Gets the number of levels.
+	std::size_t size() const noexcept;
+
+	//! @brief Gets the pack.
+	std::vector<std::byte> data() const;
+	/*! @brief Writes the pack.
+	 * @param[in] path Path of the file.
+	 * @throw std::runtime_error if the file can't be written.*/
+	void write(const std::string& path) const;
+
+	protected:
+	//! @brief Stores the levels, concatenated.
+	std::vector<std::byte> _levels;
+	//! @brief Stores the offset of each level in _levels.
+	std::vector<std::uint64_t> _offsets;
+};
+} // namespace match3
@@ -0,0 +1,30 @@
+//! @file
+#pragma once
+
+#include "Position.hpp"
+#include <ostream>
+
+namespace match3 {
+
+//! @brief A player move: swapping two adjacent items.
+struct Move {
+	//! @brief Position of the item moved.
+	Position from;
+	//! @brief Position of the neighbour it is swapped with.
+	Position to;
+
+	//! @brief Checks if the contents of this instance and rhs are equal.
+	bool operator==(const Move& rhs) const noexcept { return from == rhs.from && to == rhs.to; }
+	//! @brief Checks if the contents of this instance and rhs are differents.
+	bool operator!=(const Move& rhs) const noexcept { return !(*this == rhs); }
+
+	//! @brief Stream operator for debug purpose.
+	//! @param[in,out] os Stream to write.
+	//! @param[in] obj Move instance to log.
+	//! @return the output stream.
+	friend std::ostream& operator<<(std::ostream& os, const Move& obj) {
+		os << "{from: " << obj.from << ", to: " << obj.to << "}";
+		return os;
+	}
+};
+} // namespace match3
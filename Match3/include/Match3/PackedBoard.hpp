@@ -0,0 +1,127 @@
+//! @file
+#pragma once
+
+#include "Board.hpp"
+#include "Position.hpp"
+#include "Size.hpp"
+#include "Type.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Read-only view of a board serialized in the binary format.
+ * @details The view reads the bytes in place, there is no parse step, thus
+ * the data must outlive the view.
+ *
+ * Layout (version 1, integers are little endian):
+ * | Offset | Size | Content                                                  |
+ * |--------|------|----------------------------------------------------------|
+ * | 0      | 2    | magic `M3`                                               |
+ * | 2      | 1    | version                                                  |
+ * | 3      | 1    | bits 0-2: gravity, bit 3: 4 bits per cell (3 otherwise), |
+ * |        |      | bit 4: cell plane present, bit 5: shape plane present    |
+ * | 4      | 2    | width                                                    |
+ * | 6      | 2    | height                                                   |
+ * | 8      | 8    | @ref Random state                                        |
+ * | 16     |      | item plane: item TypeId of each cell, 0 if empty         |
+ * |        |      | cell plane (if present): Cell type TypeId of each cell   |
+ * |        |      | shape plane (if present): 1 bit per cell, set if playable |
+ *
+ * Planes are row major (see @ref BoardDelta::index), cells are packed from the
+ * least significant bit and each plane is padded to a whole byte. The shape
+ * plane is only written if a cell is blocked (see @ref Board::mask).
+ * Types are stored as @ref TypeId, thus the board must be loaded with the
+ * same palette. A 9x9 board takes 47 bytes with up to 6 types, 57 bytes with
+ * up to 14 types.*/
+class PackedBoard {
+	public:
+	//! @brief Version of the layout written by @ref pack.
+	static constexpr std::uint8_t Version = 1;
+	//! @brief Size of the header in bytes.
+	static constexpr std::size_t HeaderSize = 16;
+
+	/*! @brief Builds a view.
+	 * @param[in] data The serialized board, must outlive the view.
+	 * @throw std::runtime_error if data is not a board of a known version or is
+	 * truncated.*/
+	explicit PackedBoard(std::span<const std::byte> data);
+
+	/*! @brief Serializes a board.
+	 * @param[in] board The board to write.
+	 * @return The serialized board.
+	 * @throw std::runtime_error if the board has more than 14 types, an item
+	 * whose type is not in the palette or is larger than 65535 cells wide.*/
+	static std::vector<std::byte> pack(const Board& board);
+	/*! @brief Serializes a board given as TypeId buffers.
+	 * @details Used to write boards which are not loaded (e.g. levels).
+	 * @param[in] size Size of the board.
+	 * @param[in] items Row major item TypeIds, Type::NoneId for an empty cell.
+	 * @param[in] cells Row major cell TypeIds, empty if all cells are
+	 * Type::None.
+	 * @param[in] gravity Gravity direction.
+	 * @param[in] randomState State of the board generator.
+	 * @param[in] mask Shape of the board (see @ref Board::mask), empty if all
+	 * cells are playable.
+	 * @return The serialized board.
+	 * @throw std::runtime_error if a buffer doesn't match the size, a TypeId
+	 * is greater than 15 or the board is larger than 65535 cells wide.*/
+	static std::vector<std::byte> pack(
+	  const Size& size,
+	  std::span<const TypeId> items,
+	  std::span<const TypeId> cells       = {},
+	  Board::Gravity gravity              = Board::Gravity::Down,
+	  std::uint64_t randomState           = 0,
+	  std::span<const std::uint64_t> mask = {});
+
+	//! @brief Gets the serialized bytes.
+	std::span<const std::byte> data() const noexcept;
+	//! @brief Gets the board size.
+	Size size() const noexcept;
+	//! @brief Gets the gravity direction.
+	Board::Gravity gravity() const noexcept;
+	//! @brief Gets the state of the board generator.
+	std::uint64_t randomState() const noexcept;
+	//! @brief Gets the number of bits used by each cell (3 or 4).
+	unsigned bitsPerCell() const noexcept;
+	//! @brief Checks if the cell types are stored.
+	//! @return false if all cells have the Type::None type.
+	bool hasCellTypes() const noexcept;
+	//! @brief Checks if the shape is stored.
+	//! @return false if all cells are playable.
+	bool hasMask() const noexcept;
+
+	//! @brief Gets the type of the item at a position.
+	//! @param[in] pos Position inside the board.
+	//! @return The item TypeId, Type::NoneId if there is no item.
+	TypeId item(const Position& pos) const noexcept;
+	//! @brief Gets the type of the cell at a position.
+	//! @param[in] pos Position inside the board.
+	//! @return The cell TypeId, Type::NoneId if not stored.
+	TypeId cell(const Position& pos) const noexcept;
+	//! @brief Checks if a cell is playable.
+	//! @param[in] pos Position inside the board.
+	//! @return false if the cell is blocked.
+	bool playable(const Position& pos) const noexcept;
+
+	/*! @brief Restores the serialized board.
+	 * @details Items are created using the board types, see @ref Board::assign.
+	 * @param[in,out] board The board to restore.
+	 * @throw std::out_of_range if a TypeId is not in the board palette, the
+	 * board is left unchanged.*/
+	void unpack(Board& board) const;
+
+	protected:
+	//! @brief Gets the size in bytes of a plane.
+	std::size_t _planeSize() const noexcept;
+	//! @brief Gets the offset of the shape plane.
+	std::size_t _maskOffset() const noexcept;
+	//! @brief Reads the value of a cell.
+	TypeId _read(std::size_t offset, const Position& pos) const noexcept;
+
+	//! @brief Stores the serialized bytes.
+	std::span<const std::byte> _data;
+};
+} // namespace match3
@@ -0,0 +1,72 @@
+//! @file
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace match3 {
+
+/*! @brief Small deterministic random generator (PCG32, XSH-RR variant).
+ * @details The whole state is a single 64 bits word, so it can be stored with a
+ * board, and the sequence is the same on every platform (unlike
+ * std::uniform_int_distribution whose algorithm is implementation defined).
+ * Satisfies the UniformRandomBitGenerator requirements.*/
+class Random {
+	public:
+	using result_type = std::uint32_t;
+
+	//! @brief Builds a generator.
+	//! @param[in] seed Initial seed.
+	explicit Random(std::uint64_t seed = 0) noexcept
+	  : _state(0) {
+		this->seed(seed);
+	}
+
+	//! @brief Restarts the sequence from a seed.
+	//! @param[in] seed The seed.
+	void seed(std::uint64_t seed) noexcept {
+		_state = 0;
+		(*this)();
+		_state += seed;
+		(*this)();
+	}
+
+	//! @brief Gets the current state (e.g. to save it).
+	std::uint64_t state() const noexcept { return _state; }
+	//! @brief Restores a state returned by @ref state.
+	void setState(std::uint64_t state) noexcept { _state = state; }
+
+	static constexpr result_type min() noexcept { return 0; }
+	static constexpr result_type max() noexcept {
+		return std::numeric_limits<result_type>::max();
+	}
+
+	//! @brief Generates the next value.
+	result_type operator()() noexcept {
+		const std::uint64_t old = _state;
+		_state                  = old * kMultiplier + kIncrement;
+		const auto xorshifted   = std::uint32_t(((old >> 18u) ^ old) >> 27u);
+		const auto rot          = std::uint32_t(old >> 59u);
+		return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+	}
+
+	//! @brief Generates an unbiased value in [0, bound).
+	//! @param[in] bound Upper bound (excluded), must not be zero.
+	result_type below(result_type bound) noexcept {
+		// Rejects the first (2^32 % bound) values, so all results are equally likely.
+		const result_type threshold = (-bound) % bound;
+		for (;;) {
+			const result_type r = (*this)();
+			if (r >= threshold) return r % bound;
+		}
+	}
+
+	//! @brief Compares two generators.
+	bool operator==(const Random& rhs) const noexcept { return _state == rhs._state; }
+
+	private:
+	static constexpr std::uint64_t kMultiplier = 6364136223846793005ULL;
+	static constexpr std::uint64_t kIncrement  = 1442695040888963407ULL;
+	std::uint64_t _state;
+};
+} // namespace match3
@@ -0,0 +1,107 @@
+//! @file
+#pragma once
+
+#include "Game.hpp"
+#include "Move.hpp"
+#include <Signal/Connection.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Records a game so it can be replayed.
+ * @details The game is fully defined by its size, types, seed and moves (see
+ * @ref Game::fillBoard(std::uint64_t)), thus only those are stored, followed
+ * by the final score and @ref Game::hash to check the replay.
+ *
+ * Layout (version 2), integers are LEB128 varints unless stated otherwise:
+ * -# magic `M3R` then the version (1 byte),
+ * -# width, height,
+ * -# number of types, then each type name (length then bytes),
+ * -# seed,
+ * -# number of moves, then each move as `cell << 2 | direction` where cell is
+ * the row major index of Move::from and direction is 0: +x, 1: +y, 2: -x,
+ * 3: -y, so a move takes 1 or 2 bytes on usual boards,
+ * -# final score,
+ * -# final hash (8 bytes, little endian).*/
+class ReplayRecorder {
+	public:
+	/*! @brief Starts recording a game.
+	 * @param[in] game The game to record, must outlive the recorder.
+	 * @throw std::runtime_error if moves have been played since the last
+	 * @ref Game::fillBoard.*/
+	explicit ReplayRecorder(const Game& game);
+
+	ReplayRecorder(const ReplayRecorder&) = delete;            // no cpyable
+	ReplayRecorder& operator=(const ReplayRecorder&) = delete; // no cpy op
+
+	/*! @brief Restarts the recording from the current board.
+	 * @details To call after @ref Game::fillBoard.
+	 * @throw std::runtime_error if moves have been played since the last
+	 * @ref Game::fillBoard.*/
+	void restart();
+
+	//! @brief Gets the number of moves recorded.
+	std::size_t size() const noexcept;
+
+	//! @brief Gets the replay of the game up to now.
+	//! @return The encoded replay.
+	std::vector<std::byte> data() const;
+
+	protected:
+	//! @brief Records a move.
+	void _record(const Move& move);
+
+	//! @brief Stores the game recorded.
+	const Game& _game;
+	//! @brief Stores the header, up to the seed.
+	std::vector<std::byte> _header;
+	//! @brief Stores the encoded moves.
+	std::vector<std::byte> _moves;
+	//! @brief Stores the number of moves.
+	std::size_t _count;
+	//! @brief Stores the connection to Game::played.
+	Signal::Connection _connection;
+};
+
+/*! @brief Replays recorded games without any observer, at engine speed.
+ * @details The game is reused between runs, so replaying many games of the
+ * same size and types doesn't allocate the board again.*/
+class ReplayPlayer {
+	public:
+	//! @brief Builds a player.
+	ReplayPlayer();
+
+	ReplayPlayer(const ReplayPlayer&) = delete;            // no cpyable
+	ReplayPlayer& operator=(const ReplayPlayer&) = delete; // no cpy op
+
+	//! @brief Outcome of a replay.
+	struct Result {
+		//! @brief Number of moves played.
+		std::size_t moves = 0;
+		//! @brief Score reached.
+		std::size_t score = 0;
+		//! @brief Hash of the final state.
+		std::uint64_t hash = 0;
+		//! @brief All moves were valid, the score and the hash match the
+		//! recorded ones.
+		bool valid = false;
+	};
+
+	/*! @brief Re-simulates a recorded game.
+	 * @param[in] replay Data returned by @ref ReplayRecorder::data.
+	 * @return The outcome, valid is false if a move is rejected (playback
+	 * stops there) or the final state differs.
+	 * @throw std::runtime_error if replay is not a valid replay.*/
+	Result run(std::span<const std::byte> replay);
+
+	//! @brief Gets the game of the last run, e.g. to inspect a mismatch.
+	const Game& game() const noexcept;
+
+	protected:
+	//! @brief Stores the game replayed.
+	Game _game;
+};
+} // namespace match3
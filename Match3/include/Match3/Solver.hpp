@@ -0,0 +1,105 @@
+//! @file
+#pragma once
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "PackedBoard.hpp"
+#include "Size.hpp"
+#include "Type.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace match3 {
+
+/*! @brief Finds the shortest sequence of moves reaching a goal.
+ * @details The solver copies the board into a flat array of TypeIds and
+ * replays turns as @ref Game::play does (swap, then @ref Board::resolve from
+ * both cells), so a solution found on a board with refill gives the same
+ * turns on a game with the same board and @ref Board::random state.
+ * Without refill, turns are resolved as @ref Board::resolve with refill false.
+ *
+ * The search is an iterative deepening depth first search: a solution is
+ * optimal (no shorter one exists) and a failure within the move budget is a
+ * proof, unless the node limit is reached. Children are ordered by the goal
+ * items they clear, then by the items they clear, and states already searched
+ * at the same or a deeper depth are skipped through a transposition table
+ * shared by all threads.
+ *
+ * @note Like any transposition table keyed by a hash, a collision (56 bits are
+ * compared) could wrongly skip a state.*/
+class Solver {
+	public:
+	//! @brief Goal of a puzzle.
+	struct Goal {
+		//! @brief Type of the items to clear, Type::NoneId for any type.
+		TypeId type = Type::NoneId;
+		//! @brief Number of items to clear.
+		std::size_t count = 0;
+	};
+
+	//! @brief Outcome of a @ref solve.
+	struct Result {
+		//! @brief A solution has been found.
+		bool solved = false;
+		/*! @brief The search has completed, if solved is false there is no
+		 * solution within the move budget. false if the node limit has been
+		 * reached.*/
+		bool complete = false;
+		//! @brief Moves of the solution, to play in order.
+		std::vector<Move> moves;
+		//! @brief Number of states searched.
+		std::uint64_t nodes = 0;
+		//! @brief Wall time of the search.
+		std::chrono::nanoseconds elapsed{0};
+	};
+
+	/*! @brief Builds a solver from a board.
+	 * @param[in] board The starting board, with gravity Down.
+	 * @param[in] goal The goal to reach.
+	 * @param[in] refill true to refill the board after each turn, using the
+	 * board generator.
+	 * @throw std::runtime_error if gravity is not Down, if refill is requested
+	 * with less than 2 types or a type is not in the palette.*/
+	Solver(const Board& board, Goal goal, bool refill);
+	/*! @brief Builds a solver from a level.
+	 * @param[in] level The starting board, with gravity Down.
+	 * @param[in] typeCount Number of types of the palette, used by the refill.
+	 * @param[in] goal The goal to reach.
+	 * @param[in] refill true to refill the board after each turn, using the
+	 * level generator state.
+	 * @throw std::runtime_error if gravity is not Down, if refill is requested
+	 * with less than 2 types or a TypeId is not in the palette.*/
+	Solver(const PackedBoard& level, std::size_t typeCount, Goal goal, bool refill);
+
+	Solver(const Solver&) = delete;            // no cpyable
+	Solver& operator=(const Solver&) = delete; // no cpy op
+
+	/*! @brief Searches a solution.
+	 * @param[in] maxMoves Largest number of moves of a solution.
+	 * @param[in] threads Number of threads, the moves of the first turn are
+	 * shared among them, 0 for one per hardware thread.
+	 * @param[in] maxNodes Number of states after which the search stops, 0 for
+	 * no limit.
+	 * @return The outcome, the solution is the same whatever the number of
+	 * threads.*/
+	Result solve(std::size_t maxMoves, std::size_t threads = 1, std::uint64_t maxNodes = 0) const;
+
+	protected:
+	//! @brief Stores the size of the board.
+	Size _size;
+	//! @brief Stores the item TypeId of each cell, row major.
+	std::vector<TypeId> _cells;
+	//! @brief Stores the shape of the board, see @ref Board::mask.
+	std::vector<std::uint64_t> _mask;
+	//! @brief Stores the number of types of the palette.
+	std::size_t _typeCount;
+	//! @brief Stores the state of the generator used by the refill.
+	std::uint64_t _random;
+	//! @brief Stores the goal.
+	Goal _goal;
+	//! @brief Stores if the board is refilled.
+	bool _refill;
+};
+} // namespace match3
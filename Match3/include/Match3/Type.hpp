@@ -1,11 +1,17 @@
 //! @file
 #pragma once
 
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <unordered_set>
 
 namespace match3 {
+//! @brief Compact identifier of a Type inside a @ref Types palette.
+//! @details @ref Type::NoneId and @ref Type::AnyId are reserved, palette types
+//! start at @ref Type::FirstId.
+using TypeId = std::uint8_t;
+
 //! @brief Store item type.
 class Type {
 	public:
@@ -21,6 +27,13 @@ class Type {
 	//! except @ref Type::None
 	static const Type Any;
 
+	//! @brief Identifier of @ref Type::None.
+	static constexpr TypeId NoneId = 0;
+	//! @brief Identifier of @ref Type::Any.
+	static constexpr TypeId AnyId = 1;
+	//! @brief Identifier of the first Type of a palette.
+	static constexpr TypeId FirstId = 2;
+
 	//! @brief Constructs an object with the copy of the content of other.
 	Type(const Type&) = default;
 	//! @brief Replaces the contents with a copy of the contents of other.
@@ -55,8 +68,13 @@ class Type {
 	}
 
 	private:
+	//! @brief Kinds of Type, computed once from the name.
+	enum class _Kind : std::uint8_t { None, Any, Named };
 	//! @brief Store name of the type.
 	std::string _name;
+	//! @brief Store kind of the type, so comparing with @ref Type::Any doesn't
+	//! compare names.
+	_Kind _kind;
 };
 } // namespace match3
 
@@ -6,6 +6,7 @@
 #include <ostream>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 namespace match3 {
 class Types;
@@ -21,6 +22,10 @@ using ConstTypesWkPtr = std::weak_ptr<const Types>;
 //! @brief Store item Type.
 class Types {
 	public:
+	//! @brief Maximum number of Type in the palette.
+	//! @details Identifiers go from @ref Type::FirstId up to 0xFF.
+	static constexpr std::size_t MaxSize = 0x100 - Type::FirstId;
+
 	//! @brief Constructs an empty object.
 	Types() = default;
 	//! @brief Converts a Type into a Types object.
@@ -28,9 +33,11 @@ class Types {
 	Types(const Type& type);
 	//! @brief Converts a list of Type into a Types object.
 	//! @param[in] types The objects to convert.
+	//! @throw std::runtime_error if there are more than @ref MaxSize types.
 	Types(std::initializer_list<Type> types);
 	//! @brief Converts a set of Type into a Types object.
 	//! @param[in] types The objects to convert.
+	//! @throw std::runtime_error if there are more than @ref MaxSize types.
 	Types(const std::unordered_set<Type>& types);
 	//! @brief Destructs the object.
 	~Types() = default;
@@ -79,7 +86,24 @@ class Types {
 	void clear() noexcept;
 	//! @brief Add a new type to the list of available type.
 	//! @param[in] types The new Type to add.
-	void addTypes(const std::unordered_set<Type>& types) noexcept;
+	//! @throw std::runtime_error if the palette would hold more than @ref MaxSize
+	//! types, the palette is then left unchanged.
+	void addTypes(const std::unordered_set<Type>& types);
+
+	//! @brief Gets the available Type(s) in insertion order.
+	//! @details The Type at index i has the identifier @ref Type::FirstId + i.
+	//! @return the list of available Type.
+	const std::vector<Type>& palette() const noexcept;
+	//! @brief Gets the identifier of a Type.
+	//! @param[in] type The Type requested.
+	//! @return The Type identifier, @ref Type::NoneId if type is not in the
+	//! palette.
+	TypeId id(const Type& type) const noexcept;
+	//! @brief Gets the Type of an identifier.
+	//! @param[in] id The identifier requested.
+	//! @return The corresponding Type.
+	//! @throw std::out_of_range if id is unknown.
+	const Type& type(TypeId id) const;
 
 	//! @brief Stream operator for debug purpose.
 	//! @param[in,out] os Stream to write.
@@ -90,5 +114,7 @@ class Types {
 	protected:
 	//! @brief Store list of available Type(s).
 	std::unordered_set<Type> _types;
+	//! @brief Store available Type(s) in insertion order, i.e. indexed by id.
+	std::vector<Type> _palette;
 };
 } // namespace match3
@@ -3,20 +3,375 @@
 
 #include <Match3/Types.hpp>
 #include <algorithm>
+#include <array>
+#include <exception>
+#include <limits>
 #include <random>
+#include <string>
 
 namespace match3 {
+namespace {
+//! @brief Gets a seed from the system entropy source.
+std::uint64_t
+entropy() {
+	std::random_device rd;
+	return (std::uint64_t(rd()) << 32) | rd();
+}
+
+//! @brief Number of match rounds before giving up on a stable board.
+constexpr std::size_t kMaxRounds = 1000;
+
+//! @brief Palette index of a cell without item.
+constexpr std::uint32_t kNoPick = std::numeric_limits<std::uint32_t>::max();
+
+//! @brief Checks if a palette index in a cell would complete a run of 3 with
+//! the current neighbours.
+//! @param[in] picks Palette index of each cell, row major.
+bool
+completesRun(std::span<const std::uint32_t> picks,
+             const Size& size,
+             std::size_t index,
+             std::uint32_t pick) noexcept {
+	const std::size_t width  = size.x();
+	const std::size_t height = size.y();
+	const std::size_t x      = index % width;
+	const std::size_t y      = index / width;
+	std::size_t count        = 1;
+	for (std::size_t i = x; i > 0 && picks[index - (x - i) - 1] == pick; --i)
+		++count;
+	for (std::size_t i = x + 1; i < width && picks[index + (i - x)] == pick; ++i)
+		++count;
+	if (count >= 3) return true;
+	count = 1;
+	for (std::size_t j = y; j > 0 && picks[index - (y - j + 1) * width] == pick; --j)
+		++count;
+	for (std::size_t j = y + 1; j < height && picks[index + (j - y) * width] == pick; ++j)
+		++count;
+	return count >= 3;
+}
+
+//! @brief Gets the number of mask words of a board.
+std::size_t
+maskSize(std::size_t cells) noexcept {
+	return (cells + 63) / 64;
+}
+
+/*! @brief Item types of a board as small integers, row major.
+ * @details Scanning the whole board compares these codes instead of Type
+ * names: each distinct Type gets a code once, and the wildcard is a plain
+ * code, thus @ref Type::Any items cost nothing extra per comparison.*/
+class MatchCodes {
+	public:
+	//! @brief Code of an empty cell.
+	static constexpr std::uint32_t kEmpty = 0;
+	//! @brief Code of a @ref Type::Any item.
+	static constexpr std::uint32_t kAny = 1;
+	//! @brief Code of a @ref Type::None item.
+	static constexpr std::uint32_t kNone = 2;
+
+	MatchCodes(std::span<const ItemPtr> items, const Size& size)
+	  : _width(size.x())
+	  , _height(size.y())
+	  , _codes(items.size(), kEmpty) {
+		std::vector<std::string> names;
+		for (std::size_t i = 0; i < items.size(); ++i)
+			_codes[i] = encode(items[i], names);
+	}
+
+	/*! @brief Gets the code of an item.
+	 * @param names Names of the types coded so far, a new name is appended.
+	 * Palettes are small, a linear search is enough (see Types::id).*/
+	static std::uint32_t
+	encode(const ItemPtr& item, std::vector<std::string>& names) {
+		if (!item) return kEmpty;
+		const Type type = item->type.get();
+		if (type.name() == Type::Any.name()) return kAny;
+		if (type.name() == Type::None.name()) return kNone;
+		const auto it = std::find(names.begin(), names.end(), type.name());
+		if (it != names.end()) return std::uint32_t(kNone + 1 + (it - names.begin()));
+		names.push_back(type.name());
+		return std::uint32_t(kNone + names.size());
+	}
+
+	//! @brief Checks if two codes match as their Type::operator== does.
+	static bool
+	match(std::uint32_t lhs, std::uint32_t rhs) noexcept {
+		if (lhs == kEmpty || rhs == kEmpty) return false;
+		return lhs == rhs || (lhs == kAny && rhs != kNone) || (rhs == kAny && lhs != kNone);
+	}
+
+	//! @brief Gets the code of a cell.
+	std::uint32_t
+	operator[](std::size_t index) const noexcept {
+		return _codes[index];
+	}
+	//! @brief Swaps the codes of two cells.
+	void
+	swap(std::size_t lhs, std::size_t rhs) noexcept {
+		std::swap(_codes[lhs], _codes[rhs]);
+	}
+
+	//! @brief Checks if the item of a cell is in a run of 3 items matching it,
+	//! as Item::hasMatch does.
+	bool
+	hasMatch(std::size_t index) const noexcept {
+		const std::uint32_t code = _codes[index];
+		if (code == kEmpty) return false;
+		const std::size_t x = index % _width;
+		const std::size_t y = index / _width;
+		std::size_t count   = 1;
+		for (std::size_t i = x; i > 0 && match(_codes[index - (x - i) - 1], code); --i)
+			++count;
+		for (std::size_t i = x + 1; i < _width && match(_codes[index + (i - x)], code); ++i)
+			++count;
+		if (count >= 3) return true;
+		count = 1;
+		for (std::size_t j = y; j > 0 && match(_codes[index - (y - j + 1) * _width], code); --j)
+			++count;
+		for (std::size_t j = y + 1; j < _height && match(_codes[index + (j - y) * _width], code);
+		     ++j)
+			++count;
+		return count >= 3;
+	}
+	/*! @brief Checks if any item is in a match.
+	 * @details An item is in a run of 3 items matching it iff 3 aligned cells
+	 * hold an item matching the two others, i.e. 2 of their 3 pairs match, so
+	 * each window is checked once instead of each run from each item.*/
+	bool
+	hasMatch() const noexcept {
+		auto triple = [this](std::size_t a, std::size_t b, std::size_t c) {
+			return int(match(_codes[a], _codes[b])) + int(match(_codes[a], _codes[c])) +
+			         int(match(_codes[b], _codes[c])) >=
+			       2;
+		};
+		for (std::size_t j = 0; j < _height; ++j) {
+			for (std::size_t i = 0; i < _width; ++i) {
+				const std::size_t index = j * _width + i;
+				if (i + 2 < _width && triple(index, index + 1, index + 2)) return true;
+				if (j + 2 < _height && triple(index, index + _width, index + 2 * _width))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	private:
+	//! @brief Stores the width of the board.
+	std::size_t _width;
+	//! @brief Stores the height of the board.
+	std::size_t _height;
+	//! @brief Stores the code of each cell.
+	std::vector<std::uint32_t> _codes;
+};
+} // namespace
+
+//! @details Scope guard, changes are emitted by @ref commit and dropped if the
+//! operation exits with an exception.
+class Board::_Batch {
+	public:
+	_Batch(Board& board, BoardDelta::Operation operation)
+	  : _board(board)
+	  , _done(false) {
+		_board._beginBatch(operation);
+	}
+	~_Batch() {
+		if (!_done) _board._endBatch(false);
+	}
+	_Batch(const _Batch&) = delete;
+	_Batch& operator=(const _Batch&) = delete;
+
+	//! @brief Ends the operation.
+	void commit() {
+		_done = true;
+		_board._endBatch(true);
+	}
+
+	private:
+	Board& _board;
+	bool _done;
+};
+
+Board::FallPaths::FallPaths()
+  : _gravity(Gravity::Down)
+  , _cells()
+  , _starts(1, 0)
+  , _entries()
+  , _lanes()
+  , _feeders()
+  , _below()
+  , _order() {}
+
+Board::FallPaths::FallPaths(const Size& size,
+                            std::span<const std::uint64_t> mask,
+                            Gravity gravity)
+  : _gravity(gravity)
+  , _cells()
+  , _starts(1, 0)
+  , _entries(size.x() * size.y(), npos)
+  , _lanes()
+  , _feeders(size.x() * size.y(), npos)
+  , _below(size.x() * size.y(), npos)
+  , _order() {
+	if (_gravity == Gravity::None) return;
+	const std::size_t width    = size.x();
+	const std::size_t height   = size.y();
+	const bool vertical        = _gravity == Gravity::Down || _gravity == Gravity::Up;
+	const bool reversed        = _gravity == Gravity::Up || _gravity == Gravity::Right;
+	const std::size_t lanes    = vertical ? width : height;
+	const std::size_t length   = vertical ? height : width;
+	const std::size_t laneStep = vertical ? 1 : width;
+	const std::size_t step     = vertical ? width : 1;
+	// Cell of a lane at a distance from the floor.
+	auto at = [&](std::size_t l, std::size_t k) {
+		return std::uint32_t(l * laneStep + (reversed ? length - 1 - k : k) * step);
+	};
+	auto playable = [&mask](std::size_t index) { return (mask[index / 64] >> (index % 64)) & 1; };
+	//! <OL>
+	//! <LI> Links each cell to its feeder, the straight one first.
+	for (std::size_t k = 0; k < length; ++k) {
+		for (std::size_t l = 0; l < lanes; ++l) {
+			const std::uint32_t index = at(l, k);
+			if (!playable(index)) continue;
+			if (k > 0 && playable(at(l, k - 1))) _below[index] = at(l, k - 1);
+			if (k + 1 == length) continue;
+			if (playable(at(l, k + 1))) {
+				_feeders[index] = at(l, k + 1);
+			} else if (l > 0 && playable(at(l - 1, k + 1))) {
+				_feeders[index] = at(l - 1, k + 1);
+			} else if (l + 1 < lanes && playable(at(l + 1, k + 1))) {
+				_feeders[index] = at(l + 1, k + 1);
+			}
+		}
+	}
+	//! <LI> Lists the cells of a settle step, rank by rank.
+	for (std::size_t k = 0; k + 1 < length; ++k) {
+		for (const bool straight : {true, false}) {
+			for (std::size_t l = 0; l < lanes; ++l) {
+				const std::uint32_t index = at(l, k);
+				if (_feeders[index] == npos || (_feeders[index] == at(l, k + 1)) != straight)
+					continue;
+				_order.push_back(index);
+			}
+		}
+	}
+	//! <LI> Lists the lanes from their source, each cell after the cells it
+	//! feeds (depth first).
+	_cells.reserve(_entries.size());
+	_lanes.reserve(_entries.size());
+	struct Visit {
+		std::size_t l, k, child;
+	};
+	std::vector<Visit> stack;
+	for (std::size_t l = 0; l < lanes; ++l) {
+		for (std::size_t k = length; k-- > 0;) {
+			const std::uint32_t root = at(l, k);
+			if (!playable(root) || _feeders[root] != npos) continue;
+			const std::uint32_t lane = std::uint32_t(_starts.size() - 1);
+			stack.push_back({l, k, 0});
+			while (!stack.empty()) {
+				Visit& visit = stack.back();
+				const std::uint32_t index = at(visit.l, visit.k);
+				bool pushed               = false;
+				// Straight child, then the diagonal ones in lane order.
+				while (!pushed && visit.k > 0 && visit.child < 3) {
+					const std::size_t child = visit.child++;
+					if (child == 1 && visit.l == 0) continue;
+					const std::size_t cl = child == 0 ? visit.l : child == 1 ? visit.l - 1 : visit.l + 1;
+					if (cl >= lanes || _feeders[at(cl, visit.k - 1)] != index) continue;
+					stack.push_back({cl, visit.k - 1, 0});
+					pushed = true;
+				}
+				if (pushed) continue;
+				_entries[index] = std::uint32_t(_cells.size());
+				_cells.push_back(index);
+				_lanes.push_back(lane);
+				stack.pop_back();
+			}
+			_starts.push_back(std::uint32_t(_cells.size()));
+		}
+	}
+	//! </OL>
+}
+
+Board::Gravity
+Board::FallPaths::gravity() const noexcept {
+	return _gravity;
+}
+
+std::size_t
+Board::FallPaths::laneCount() const noexcept {
+	return _starts.size() - 1;
+}
+
+std::span<const std::uint32_t>
+Board::FallPaths::lane(std::size_t lane) const noexcept {
+	return std::span<const std::uint32_t>(_cells).subspan(_starts[lane],
+	                                                      _starts[lane + 1] - _starts[lane]);
+}
+
+std::uint32_t
+Board::FallPaths::laneOf(std::size_t index) const noexcept {
+	const std::uint32_t entry = _entries[index];
+	return entry == npos ? npos : _lanes[entry];
+}
+
+std::uint32_t
+Board::FallPaths::rankOf(std::size_t index) const noexcept {
+	const std::uint32_t lane = laneOf(index);
+	if (lane == npos) return npos;
+	return _entries[index] - _starts[lane];
+}
+
+std::uint32_t
+Board::FallPaths::feeder(std::size_t index) const noexcept {
+	return _feeders[index];
+}
+
+std::uint32_t
+Board::FallPaths::below(std::size_t index) const noexcept {
+	return _below[index];
+}
+
+std::span<const std::uint32_t>
+Board::FallPaths::order() const noexcept {
+	return _order;
+}
+
 Board::Board(ConstTypesWkPtr types)
-  : _types(std::move(types))
+  : changed()
+  , _types(std::move(types))
   , _size({0, 0})
-  , _gravity(Gravity::Down) {}
+  , _cells()
+  , _items()
+  , _mask()
+  , _itemCount(0)
+  , _random(entropy())
+  , _marks()
+  , _mark(0)
+  , _skips()
+  , _origins()
+  , _codes()
+  , _gravity(Gravity::Down)
+  , _fallPaths()
+  , _batchDepth(0)
+  , _recording(false)
+  , _recordTypes()
+  , _tracks()
+  , _delta() {}
 
 void
 Board::clear() {
-	_items.clear();
+	_Batch batch(*this, BoardDelta::Operation::Clear);
+	for (ItemPtr& it : _items) {
+		if (!it) continue;
+		_touchRemoved(*it);
+		it.reset();
+	}
+	_itemCount = 0;
 	for (const CellPtr& cell : _cells) {
 		cell->type.set(Type::None);
 	}
+	batch.commit();
 }
 
 const Size&
@@ -26,17 +381,36 @@ Board::size() const noexcept {
 
 void
 Board::resize(Size size) {
+	_Batch batch(*this, BoardDelta::Operation::Resize);
+	// Cell indexes of the previous size are meaningless, observers must rebuild.
+	_tracks.clear();
 	_items.clear();
 	_cells.clear();
+	_itemCount = 0;
 
 	_size = std::move(size);
-	for (Size::value_type i = 0; i < _size.x(); ++i) {
-		for (Size::value_type j = 0; j < _size.y(); ++j) {
+	const std::size_t count = _size.x() * _size.y();
+	_cells.reserve(count);
+	for (Size::value_type j = 0; j < _size.y(); ++j) {
+		for (Size::value_type i = 0; i < _size.x(); ++i) {
 			CellPtr cell = std::make_shared<Cell>(shared_from_this());
 			cell->position.set(Position(i, j));
-			_cells.insert(cell);
+			_cells.push_back(cell);
 		}
 	}
+	_items.resize(count);
+	_setMask({});
+	_marks.assign(count, 0);
+	_mark = 0;
+	_skips.assign(count, FallPaths::npos);
+	_origins.assign(count, FallPaths::npos);
+	_codes.assign(count, 0);
+	batch.commit();
+}
+
+ConstTypesPtr
+Board::types() const noexcept {
+	return _types.lock();
 }
 
 std::vector<ConstCellPtr>
@@ -59,92 +433,192 @@ Board::cells() {
 
 ConstCellPtr
 Board::cell(const Position& pos) const {
-	std::unordered_set<CellPtr>::const_iterator res =
-	  std::find_if(_cells.begin(), _cells.end(), [&pos](const CellPtr& it) {
-		  return it->position.get() == pos;
-	  });
-	if (res != _cells.end())
-		return *res;
-	else
-		return ConstCellPtr();
+	if (!_contains(pos)) return ConstCellPtr();
+	return _cells[_index(pos)];
 }
 
 CellPtr
 Board::cell(const Position& pos) {
-	std::unordered_set<CellPtr>::iterator res =
-	  std::find_if(_cells.begin(), _cells.end(), [&pos](const CellPtr& it) {
-		  return it->position.get() == pos;
-	  });
-	if (res != _cells.end())
-		return *res;
-	else
-		return CellPtr();
+	if (!_contains(pos)) return CellPtr();
+	return _cells[_index(pos)];
+}
+
+bool
+Board::playable(const Position& pos) const noexcept {
+	return _contains(pos) && _playable(_index(pos));
+}
+
+void
+Board::setPlayable(const Position& pos, bool playable) {
+	if (!_contains(pos) || playable == this->playable(pos)) return;
+	std::vector<std::uint64_t> mask = _mask;
+	const std::size_t index         = _index(pos);
+	mask[index / 64] ^= std::uint64_t(1) << (index % 64);
+	setMask(mask);
+}
+
+std::span<const std::uint64_t>
+Board::mask() const noexcept {
+	return _mask;
+}
+
+void
+Board::setMask(std::span<const std::uint64_t> mask) {
+	if (!mask.empty() && mask.size() != maskSize(_cells.size())) {
+		throw std::runtime_error("Mask size doesn't match the board size.");
+	}
+	_Batch batch(*this, BoardDelta::Operation::Shape);
+	_setMask(mask);
+	batch.commit();
 }
 
 std::vector<ConstItemPtr>
 Board::items() const {
 	std::vector<ConstItemPtr> res;
-	res.reserve(_items.size());
+	res.reserve(_itemCount);
 	for (const auto& it : _items)
-		res.push_back(it);
+		if (it) res.push_back(it);
 	return res;
 }
 
 std::vector<ItemPtr>
 Board::items() {
 	std::vector<ItemPtr> res;
-	res.reserve(_items.size());
+	res.reserve(_itemCount);
 	for (const auto& it : _items)
-		res.push_back(it);
+		if (it) res.push_back(it);
 	return res;
 }
 
 ConstItemPtr
 Board::item(const Position& pos) const {
-	std::unordered_set<ItemPtr>::const_iterator res =
-	  std::find_if(_items.begin(), _items.end(), [&pos](const ItemPtr& it) {
-		  return it->position.get() == pos;
-	  });
-	if (res != _items.end())
-		return *res;
-	else
-		return ConstItemPtr();
+	if (!_contains(pos)) return ConstItemPtr();
+	return _items[_index(pos)];
 }
 
 ItemPtr
 Board::item(const Position& pos) {
-	std::unordered_set<ItemPtr>::iterator res =
-	  std::find_if(_items.begin(), _items.end(), [&pos](const ItemPtr& it) {
-		  return it->position.get() == pos;
-	  });
-	if (res != _items.end())
-		return *res;
-	else
-		return ItemPtr();
+	if (!_contains(pos)) return ItemPtr();
+	return _items[_index(pos)];
 }
 
 void
 Board::addItem(ItemPtr it) {
-	if (item(it->position.get())) {
+	const Position pos = it->position.get();
+	if (!_contains(pos)) {
+		throw std::runtime_error("Item position outside the board.");
+	}
+	if (!_playable(_index(pos))) {
+		throw std::runtime_error("Item position blocked.");
+	}
+	ItemPtr& slot = _items[_index(pos)];
+	if (slot) {
 		throw std::runtime_error("Item already at this position.");
 	}
+	_Batch batch(*this, BoardDelta::Operation::Add);
 	it->board.set(shared_from_this());
-	_items.insert(it);
+	slot = it;
+	++_itemCount;
+	_touchAdded(*it);
+	batch.commit();
+}
+
+void
+Board::addItems(const std::vector<ItemPtr>& items) {
+	// Marks the cells taken by the new items, to find collisions between them.
+	const std::uint32_t mark = _nextMark();
+	for (const ItemPtr& it : items) {
+		const Position pos = it->position.get();
+		if (!_contains(pos)) {
+			throw std::runtime_error("Item position outside the board.");
+		}
+		const std::size_t index = _index(pos);
+		if (!_playable(index)) {
+			throw std::runtime_error("Item position blocked.");
+		}
+		if (_items[index] || _marks[index] == mark) {
+			throw std::runtime_error("Item already at this position.");
+		}
+		_marks[index] = mark;
+	}
+
+	_Batch batch(*this, BoardDelta::Operation::Add);
+	if (_recording) _tracks.reserve(_tracks.size() + items.size());
+	const BoardPtr board = shared_from_this();
+	for (const ItemPtr& it : items) {
+		it->board.set(board);
+		_items[_index(it->position.get())] = it;
+		_touchAdded(*it);
+	}
+	_itemCount += items.size();
+	batch.commit();
+}
+
+void
+Board::assign(
+  std::span<const TypeId> items,
+  const Size& size,
+  std::span<const TypeId> cells,
+  std::span<const std::uint64_t> mask) {
+	const std::size_t count = size.x() * size.y();
+	if (items.size() != count || (!cells.empty() && cells.size() != count) ||
+	    (!mask.empty() && mask.size() != maskSize(count))) {
+		throw std::runtime_error("Buffer size doesn't match the board size.");
+	}
+	// Resolves each TypeId once, before touching the board.
+	ConstTypesPtr types = _types.lock();
+	std::array<const Type*, std::numeric_limits<TypeId>::max() + 1> lookup{};
+	lookup[Type::NoneId] = &Type::None;
+	lookup[Type::AnyId]  = &Type::Any;
+	for (std::size_t i = 0; types && i < types->size(); ++i) {
+		lookup[Type::FirstId + i] = &types->palette()[i];
+	}
+	auto check = [&lookup](std::span<const TypeId> ids) {
+		for (TypeId id : ids) {
+			if (!lookup[id]) throw std::out_of_range("Unknown type id.");
+		}
+	};
+	check(items);
+	check(cells);
+	for (std::size_t i = 0; !mask.empty() && i < count; ++i) {
+		if (items[i] != Type::NoneId && !((mask[i / 64] >> (i % 64)) & 1)) {
+			throw std::runtime_error("Item position blocked.");
+		}
+	}
+
+	_Batch batch(*this, BoardDelta::Operation::Assign);
+	if (size != _size) {
+		resize(size);
+	} else {
+		clear();
+	}
+	// The board is empty, so no item is removed.
+	_setMask(mask);
+	if (_recording) _tracks.reserve(count);
+	const BoardPtr board = shared_from_this();
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!cells.empty()) _cells[i]->type.set(*lookup[cells[i]]);
+		if (items[i] == Type::NoneId) continue;
+		_items[i] = std::make_shared<Item>(*lookup[items[i]], _cells[i]->position.get(), board);
+		++_itemCount;
+		_touchAdded(*_items[i]);
+	}
+	batch.commit();
 }
 
 ItemPtr
 Board::removeItem(const Position& pos) {
-	std::unordered_set<ItemPtr>::iterator it =
-	  std::find_if(_items.begin(), _items.end(), [&pos](const ItemPtr& item) {
-		  return item->position.get() == pos;
-	  });
-	if (it != _items.end()) {
-		ItemPtr res = *it;
-		res->alive.set(false);
-		_items.erase(it);
-		return res;
-	} else
-		return ItemPtr();
+	if (!_contains(pos)) return ItemPtr();
+	ItemPtr& slot = _items[_index(pos)];
+	if (!slot) return ItemPtr();
+
+	_Batch batch(*this, BoardDelta::Operation::Removal);
+	ItemPtr res = std::move(slot);
+	_touchRemoved(*res);
+	res->alive.set(false);
+	--_itemCount;
+	batch.commit();
+	return res;
 }
 
 ItemPtr
@@ -155,65 +629,147 @@ Board::removeItem(const ConstItemPtr& item) {
 
 std::vector<ItemPtr>
 Board::removeItems(const std::vector<Position>& positions) {
+	_Batch batch(*this, BoardDelta::Operation::Removal);
 	std::vector<ItemPtr> res;
 	res.reserve(positions.size());
 	for (const auto& pos : positions) {
 		ItemPtr it = removeItem(pos);
 		if (it) res.push_back(it);
 	}
+	batch.commit();
 	return res;
 }
 
 std::vector<ItemPtr>
 Board::removeItems(const std::vector<ConstItemPtr>& items) {
+	_Batch batch(*this, BoardDelta::Operation::Removal);
 	std::vector<ItemPtr> res;
 	res.reserve(items.size());
 	for (const ConstItemPtr& it : items) {
 		ItemPtr tmp = removeItem(it);
 		if (tmp) res.push_back(tmp);
 	}
+	batch.commit();
 	return res;
 }
 
+bool
+Board::swap(const Position& lhs, const Position& rhs) {
+	const Position diff = lhs - rhs;
+	if (std::abs(diff.x()) + std::abs(diff.y()) != 1) return false;
+	if (!_contains(lhs) || !_contains(rhs)) return false;
+	ItemPtr& lhsItem = _items[_index(lhs)];
+	ItemPtr& rhsItem = _items[_index(rhs)];
+	if (!lhsItem || !rhsItem) return false;
+
+	_Batch batch(*this, BoardDelta::Operation::Swap);
+	_touch(*lhsItem);
+	_touch(*rhsItem);
+	lhsItem->position.set(rhs);
+	rhsItem->position.set(lhs);
+	std::swap(lhsItem, rhsItem);
+	const bool match = lhsItem->hasMatch() || rhsItem->hasMatch();
+	if (!match) {
+		lhsItem->position.set(rhs);
+		rhsItem->position.set(lhs);
+		std::swap(lhsItem, rhsItem);
+	}
+	batch.commit();
+	return match;
+}
+
+ItemPtr
+Board::setItemType(const Position& pos, const Type& type) {
+	ItemPtr it = item(pos);
+	if (it) {
+		_Batch batch(*this, BoardDelta::Operation::Retype);
+		_touch(*it);
+		it->type.set(type);
+		batch.commit();
+	}
+	return it;
+}
+
 Board::Gravity
 Board::gravity() const noexcept {
 	return _gravity;
 }
 
 void
-Board::setGravity(const Gravity& gravity) noexcept {
-	_gravity = gravity;
+Board::setGravity(const Gravity& gravity) {
+	if (gravity == _gravity) return;
+	_gravity   = gravity;
+	_fallPaths = FallPaths(_size, _mask, _gravity);
+}
+
+const Board::FallPaths&
+Board::fallPaths() const noexcept {
+	return _fallPaths;
+}
+
+Random&
+Board::random() noexcept {
+	return _random;
+}
+
+const Random&
+Board::random() const noexcept {
+	return _random;
 }
 
 void
-Board::fill() {
+Board::fill(bool stable) {
+	_Batch batch(*this, BoardDelta::Operation::Fill);
 	//! <OL>
 	clear();
 
-	//! <LI> Create all items
-	{
-		// Get Types
-		ConstTypesPtr types = _types.lock();
-		if (!types || types->size() == 0) {
-			throw std::runtime_error("Types empty.");
-		}
-		// Create uniform random generator for item's type
-		std::random_device rd;
-		std::mt19937 gen(rd());
-		std::uniform_int_distribution<> dis(0, types->size() - 1);
-
-		std::vector<Type> typeNames;
-		typeNames.reserve(types->size());
-		for (auto const& it : *types) {
-			typeNames.push_back(it.name());
-		}
-		// Create item using the generator.
-		for (const CellPtr& cPtr : _cells) {
-			_items.insert(std::make_shared<Item>(
-			  typeNames[dis(gen)], cPtr->position.get(), shared_from_this()));
+	// Get Types
+	ConstTypesPtr types = _types.lock();
+	if (!types || types->size() == 0) {
+		throw std::runtime_error("Types empty.");
+	}
+	if (stable && types->size() < 2) {
+		throw std::runtime_error("Stable fill needs at least 2 types.");
+	}
+	const std::vector<Type>& palette = types->palette();
+	const std::uint32_t count        = std::uint32_t(palette.size());
+	//! <LI> Draws the type of all items, row by row so a seed gives the same
+	//! board.
+	std::vector<std::uint32_t> picks(_cells.size(), kNoPick);
+	for (std::size_t i = 0; i < _cells.size(); ++i) {
+		if (_playable(i)) picks[i] = _random.below(count);
+	}
+	//! <LI> Removes the initial matches if requested: each cell of a run is
+	//! re-rolled to a type completing no run with its current neighbours (if
+	//! any), so the rounds are few.
+	if (stable) {
+		std::vector<std::uint32_t> runs;
+		for (std::size_t round = 0;; ++round) {
+			runs.clear();
+			for (std::size_t i = 0; i < picks.size(); ++i) {
+				if (picks[i] != kNoPick && completesRun(picks, _size, i, picks[i]))
+					runs.push_back(std::uint32_t(i));
+			}
+			if (runs.empty()) break;
+			if (round == kMaxRounds) throw std::runtime_error("Unable to fill a stable board.");
+			for (std::uint32_t index : runs) {
+				const std::uint32_t first = _random.below(count);
+				picks[index]              = first;
+				for (std::uint32_t k = 0; k < count; ++k) {
+					const std::uint32_t pick = (first + k) % count;
+					if (completesRun(picks, _size, index, pick)) continue;
+					picks[index] = pick;
+					break;
+				}
+			}
 		}
 	}
+	//! <LI> Creates all items.
+	for (std::size_t i = 0; i < _cells.size(); ++i) {
+		if (picks[i] != kNoPick) _spawn(i, palette[picks[i]]);
+	}
 	//! </OL>
+	batch.commit();
 }
 
 bool
@@ -232,17 +788,15 @@ Board::hasMatch(const ConstItemPtr& item) const noexcept {
 
 bool
 Board::hasMatch() const noexcept {
-	for (const ItemPtr& item : _items) {
-		if (item->hasMatch()) return true;
-	}
-	return false;
+	return MatchCodes(_items, _size).hasMatch();
 }
 
 std::vector<ConstItemPtr>
 Board::getMatches() const {
 	std::vector<ConstItemPtr> res;
-	for (const ItemPtr& item : _items) {
-		if (item->hasMatch()) res.push_back(item);
+	const MatchCodes codes(_items, _size);
+	for (std::size_t i = 0; i < _items.size(); ++i) {
+		if (codes.hasMatch(i)) res.push_back(_items[i]);
 	}
 	return res;
 }
@@ -254,21 +808,412 @@ Board::findandRemoveMatches() {
 
 std::vector<ItemPtr>
 Board::iterate() {
+	if (_gravity == Gravity::None) throw std::runtime_error("Gravity direction not supported yet.");
+	std::vector<ItemPtr> res;
+	_Batch batch(*this, BoardDelta::Operation::Settle);
+	const std::size_t width = _size.x();
+	for (std::uint32_t index : _fallPaths.order()) {
+		ItemPtr& currentItem = _items[index];
+		ItemPtr& upperItem   = _items[_fallPaths.feeder(index)];
+		if (currentItem || !upperItem) continue;
+		_touch(*upperItem);
+		upperItem->position.set(Position(int(index % width), int(index / width)));
+		res.push_back(upperItem);
+		currentItem = std::move(upperItem);
+	}
+	batch.commit();
+	return res;
+}
+
+std::vector<ItemPtr>
+Board::cascade(CascadeProfile* profile) {
+	using Clock = std::chrono::steady_clock;
+	_Batch batch(*this, BoardDelta::Operation::Cascade);
+	if (profile) *profile = CascadeProfile();
 	std::vector<ItemPtr> res;
+	Clock::time_point start = profile ? Clock::now() : Clock::time_point();
+	for (std::vector<ItemPtr> removed = findandRemoveMatches(); !removed.empty();
+	     removed                      = findandRemoveMatches()) {
+		if (profile) {
+			const Clock::time_point now = Clock::now();
+			profile->match += now - start;
+			start = now;
+		}
+		res.insert(res.end(), removed.begin(), removed.end());
+		while (!iterate().empty()) {
+		}
+		if (profile) {
+			const Clock::time_point now = Clock::now();
+			profile->settle += now - start;
+			profile->rounds++;
+			start = now;
+		}
+	}
+	// Last search, which found no match.
+	if (profile) profile->match += Clock::now() - start;
+	batch.commit();
+	return res;
+}
+
+Board::Resolution
+Board::resolve(std::span<const Position> seeds, bool refill, CascadeProfile* profile) {
+	std::vector<std::uint32_t> candidates;
+	candidates.reserve(seeds.size());
+	for (const Position& pos : seeds) {
+		if (_contains(pos)) candidates.push_back(std::uint32_t(_index(pos)));
+	}
+	return _resolve(candidates, refill, profile);
+}
 
-	if (_gravity == Gravity::Down) {
-		for (int j = 0; j < int(_size.y() - 1); ++j) {
-			for (int i = 0; i < int(_size.x()); ++i) {
-				ItemPtr upperItem   = item({i, j + 1});
-				ItemPtr currentItem = item({i, j});
-				if ((!currentItem) && upperItem) {
-					upperItem->position.set({i, j});
-					res.push_back(upperItem);
+template <typename Visitor>
+void
+Board::_visitMoves(Visitor&& visit) const noexcept {
+	const std::size_t width  = _size.x();
+	const std::size_t height = _size.y();
+	// Swaps are played on the codes, then undone.
+	MatchCodes codes(_items, _size);
+	for (std::size_t j = 0; j < height; ++j) {
+		for (std::size_t i = 0; i < width; ++i) {
+			const std::size_t lhs = j * width + i;
+			if (codes[lhs] == MatchCodes::kEmpty) continue;
+			for (const bool vertical : {false, true}) {
+				if (vertical ? j + 1 >= height : i + 1 >= width) continue;
+				const std::size_t rhs = lhs + (vertical ? width : 1);
+				// Swapping two items of the same type changes nothing, unlike a
+				// wildcard swapped with another item.
+				if (codes[rhs] == MatchCodes::kEmpty ||
+				    (codes[lhs] == codes[rhs] && codes[lhs] != MatchCodes::kAny))
+					continue;
+				codes.swap(lhs, rhs);
+				const bool match = codes.hasMatch(lhs) || codes.hasMatch(rhs);
+				codes.swap(lhs, rhs);
+				const Position from = Position(int(i), int(j));
+				if (match && !visit(Move{from, from + Position(vertical ? 0 : 1, vertical ? 1 : 0)}))
+					return;
+			}
+		}
+	}
+}
+
+std::optional<Move>
+Board::findMove() const noexcept {
+	std::optional<Move> res;
+	_visitMoves([&res](const Move& move) {
+		res = move;
+		return false;
+	});
+	return res;
+}
+
+bool
+Board::hasMove() const noexcept {
+	return findMove().has_value();
+}
+
+std::size_t
+Board::moveCount(std::size_t limit) const noexcept {
+	std::size_t res = 0;
+	if (limit == 0) return res;
+	_visitMoves([&res, limit](const Move&) { return ++res < limit; });
+	return res;
+}
+
+void
+Board::_beginBatch(BoardDelta::Operation operation) {
+	if (_batchDepth++ != 0) return;
+	_recording = !changed.empty();
+	if (!_recording) return;
+	_recordTypes = _types.lock();
+	_delta.clear();
+	_delta.operation = operation;
+	_delta.size      = _size;
+	_tracks.clear();
+}
+
+void
+Board::_endBatch(bool commit) {
+	if (--_batchDepth != 0 || !_recording) return;
+	_recording = false;
+	if (commit) {
+		_delta.size = _size;
+		for (const auto& [item, track] : _tracks) {
+			const std::uint32_t cell = _delta.index(item->position.get());
+			const TypeId type = _recordTypes ? _recordTypes->id(item->type.get()) : Type::NoneId;
+			if (track.added) {
+				_delta.added.push_back({cell, type});
+				continue;
+			}
+			if (cell != track.origin) _delta.moved.push_back({track.origin, cell, track.type});
+			if (type != track.type) _delta.retyped.push_back({cell, track.type, type});
+		}
+		std::sort(_delta.added.begin(), _delta.added.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.cell < rhs.cell;
+		});
+		std::sort(_delta.removed.begin(), _delta.removed.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.cell < rhs.cell;
+		});
+		std::sort(_delta.moved.begin(), _delta.moved.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.from < rhs.from;
+		});
+		std::sort(_delta.retyped.begin(), _delta.retyped.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.cell < rhs.cell;
+		});
+	}
+	_tracks.clear();
+	_recordTypes.reset();
+	if (commit && (!_delta.empty() || _delta.operation == BoardDelta::Operation::Resize)) {
+		changed.emit(_delta);
+	}
+}
+
+void
+Board::_touch(const Item& item) {
+	if (!_recording) return;
+	_tracks.try_emplace(&item,
+	                    _Track{_delta.index(item.position.get()),
+	                           _recordTypes ? _recordTypes->id(item.type.get()) : Type::NoneId,
+	                           false});
+}
+
+void
+Board::_touchAdded(const Item& item) {
+	if (!_recording) return;
+	_tracks[&item] = _Track{0, Type::NoneId, true};
+}
+
+void
+Board::_touchRemoved(const Item& item) {
+	if (!_recording) return;
+	auto it = _tracks.find(&item);
+	if (it == _tracks.end()) {
+		_delta.removed.push_back(
+		  {_delta.index(item.position.get()),
+		   _recordTypes ? _recordTypes->id(item.type.get()) : Type::NoneId});
+		return;
+	}
+	// Items created by this operation are simply forgotten.
+	if (!it->second.added) _delta.removed.push_back({it->second.origin, it->second.type});
+	_tracks.erase(it);
+}
+
+bool
+Board::_contains(const Position& pos) const noexcept {
+	return pos.x() >= 0 && pos.y() >= 0 && std::size_t(pos.x()) < _size.x() &&
+	       std::size_t(pos.y()) < _size.y();
+}
+
+std::size_t
+Board::_index(const Position& pos) const noexcept {
+	return std::size_t(pos.y()) * _size.x() + std::size_t(pos.x());
+}
+
+bool
+Board::_playable(std::size_t index) const noexcept {
+	return (_mask[index / 64] >> (index % 64)) & 1;
+}
+
+void
+Board::_setMask(std::span<const std::uint64_t> mask) {
+	const std::size_t count = _cells.size();
+	if (mask.empty()) {
+		_mask.assign(maskSize(count), ~std::uint64_t(0));
+	} else {
+		_mask.assign(mask.begin(), mask.end());
+	}
+	// Clears the bits past the last cell.
+	if (count % 64) _mask.back() &= (std::uint64_t(1) << (count % 64)) - 1;
+	_fallPaths = FallPaths(_size, _mask, _gravity);
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!_items[i] || _playable(i)) continue;
+		ItemPtr it = std::move(_items[i]);
+		_touchRemoved(*it);
+		it->alive.set(false);
+		--_itemCount;
+	}
+}
+
+std::uint32_t
+Board::_nextMark() {
+	if (_mark == std::numeric_limits<std::uint32_t>::max()) {
+		std::fill(_marks.begin(), _marks.end(), 0);
+		std::fill(_codes.begin(), _codes.end(), 0);
+		_mark = 0;
+	}
+	return ++_mark;
+}
+
+void
+Board::_spawn(std::size_t index, const Type& type) {
+	ItemPtr it = std::make_shared<Item>(type, _cells[index]->position.get(), shared_from_this());
+	_items[index] = it;
+	++_itemCount;
+	_touchAdded(*it);
+}
+
+Board::Resolution
+Board::_resolve(std::vector<std::uint32_t>& candidates, bool refill, CascadeProfile* profile) {
+	using Clock = std::chrono::steady_clock;
+	if (_gravity == Gravity::None) throw std::runtime_error("Gravity direction not supported yet.");
+	ConstTypesPtr types;
+	if (refill) {
+		types = _types.lock();
+		if (!types || types->size() == 0) throw std::runtime_error("Types empty.");
+		// A single type would match forever.
+		if (types->size() < 2) throw std::runtime_error("Refill needs at least 2 types.");
+	}
+	_Batch batch(*this, BoardDelta::Operation::Cascade);
+	if (profile) *profile = CascadeProfile();
+	Resolution res;
+	const std::size_t width  = _size.x();
+	const std::size_t height = _size.y();
+	const bool vertical      = _gravity == Gravity::Down || _gravity == Gravity::Up;
+	constexpr std::size_t npos = FallPaths::npos;
+	// Moved items whose lane neighbours are unchanged, only checked across the lane.
+	std::vector<std::uint32_t> shifted;
+	std::vector<std::uint32_t> removed;
+	// Lowest rank emptied in each lane, npos if none.
+	std::vector<std::size_t> holes(_fallPaths.laneCount(), npos);
+	std::vector<std::size_t> lanes;
+	// Type names of the match codes, see MatchCodes::encode.
+	std::vector<std::string> names;
+
+	Clock::time_point start = profile ? Clock::now() : Clock::time_point();
+	auto lap = [&](std::chrono::nanoseconds CascadeProfile::*phase) {
+		if (!profile) return;
+		const Clock::time_point now = Clock::now();
+		profile->*phase += now - start;
+		start = now;
+	};
+	while (!candidates.empty() || !shifted.empty()) {
+		//! <OL>
+		//! <LI> Finds the runs going through a candidate, each run is marked once.
+		const std::uint32_t mark = _nextMark();
+		removed.clear();
+		// Codes are cached per round, items only move once the runs are found.
+		auto code = [&](std::size_t index) {
+			std::uint64_t& entry = _codes[index];
+			if (entry >> 32 != mark)
+				entry = std::uint64_t(mark) << 32 | MatchCodes::encode(_items[index], names);
+			return std::uint32_t(entry);
+		};
+		auto same = [&](std::size_t index, std::uint32_t type) {
+			return MatchCodes::match(code(index), type);
+		};
+		auto take = [&](std::size_t first, std::size_t last, std::size_t step) {
+			if ((last - first) / step + 1 < 3) return;
+			for (std::size_t k = first; k <= last; k += step) {
+				if (_marks[k] == mark) continue;
+				_marks[k] = mark;
+				removed.push_back(std::uint32_t(k));
+			}
+		};
+		auto check = [&](std::size_t index, bool alongX, bool alongY) {
+			const std::uint32_t type = code(index);
+			if (type == MatchCodes::kEmpty) return;
+			const std::size_t x = index % width;
+			const std::size_t y = index / width;
+			std::size_t first = index, last = index;
+			if (alongX) {
+				for (std::size_t i = x; i > 0 && same(first - 1, type); --i)
+					--first;
+				for (std::size_t i = x + 1; i < width && same(last + 1, type); ++i)
+					++last;
+				take(first, last, 1);
+			}
+			if (!alongY) return;
+			first = last = index;
+			for (std::size_t j = y; j > 0 && same(first - width, type); --j)
+				first -= width;
+			for (std::size_t j = y + 1; j < height && same(last + width, type); ++j)
+				last += width;
+			take(first, last, width);
+		};
+		for (std::uint32_t index : candidates)
+			check(index, true, true);
+		for (std::uint32_t index : shifted)
+			check(index, vertical, !vertical);
+		lap(&CascadeProfile::match);
+		if (removed.empty()) break;
+		if (refill && res.rounds == kMaxRounds)
+			throw std::runtime_error("Unable to stabilise the board.");
+		++res.rounds;
+		res.removed += removed.size();
+
+		//! <LI> Removes matched items, recording the lowest hole of each lane.
+		lanes.clear();
+		for (std::uint32_t index : removed) {
+			ItemPtr it = std::move(_items[index]);
+			_touchRemoved(*it);
+			it->alive.set(false);
+			--_itemCount;
+			const std::size_t lane = _fallPaths.laneOf(index);
+			if (holes[lane] == npos) lanes.push_back(lane);
+			holes[lane] = std::min<std::size_t>(holes[lane], _fallPaths.rankOf(index));
+		}
+		lap(&CascadeProfile::match);
+
+		//! <LI> Settles the lanes with holes along the fall paths: each empty
+		//! cell, in lane order, takes the nearest item up its feeders. Moved
+		//! items become candidates, but the ones falling with the item below
+		//! them keep their lane neighbours, so they are only checked across the
+		//! lane.
+		candidates.clear();
+		shifted.clear();
+		for (std::size_t l : lanes) {
+			const std::span<const std::uint32_t> lane = _fallPaths.lane(l);
+			for (std::size_t k = holes[l]; k < lane.size(); ++k) {
+				_skips[lane[k]] = _fallPaths.feeder(lane[k]);
+			}
+			for (std::size_t k = holes[l]; k < lane.size(); ++k) {
+				const std::uint32_t to = lane[k];
+				if (_items[to]) continue;
+				// The empty cells passed stay empty until their turn, later
+				// searches skip them.
+				std::uint32_t from = _skips[to];
+				while (from != npos && !_items[from])
+					from = _skips[from];
+				for (std::uint32_t i = _skips[to]; i != from;) {
+					const std::uint32_t up = _skips[i];
+					_skips[i]              = from;
+					i                      = up;
 				}
+				if (from == npos) continue;
+				ItemPtr& it = _items[from];
+				_touch(*it);
+				it->position.set(Position(int(to % width), int(to / width)));
+				_items[to]                = std::move(it);
+				_origins[to]              = from;
+				const std::uint32_t below = _fallPaths.below(to);
+				const bool together       = below != npos && _origins[below] != npos &&
+				                      _origins[below] == _fallPaths.below(from);
+				(together ? shifted : candidates).push_back(to);
 			}
 		}
-	} else
-		throw std::runtime_error("Gravity direction not supported yet.");
+		for (std::uint32_t index : candidates)
+			_origins[index] = npos;
+		for (std::uint32_t index : shifted)
+			_origins[index] = npos;
+		lap(&CascadeProfile::settle);
+
+		//! <LI> Refills the cells left empty, new items become candidates.
+		for (std::size_t l : lanes) {
+			if (refill) {
+				const std::span<const std::uint32_t> lane = _fallPaths.lane(l);
+				const std::vector<Type>& palette          = types->palette();
+				for (std::size_t k = holes[l]; k < lane.size(); ++k) {
+					if (_items[lane[k]]) continue;
+					_spawn(lane[k], palette[_random.below(std::uint32_t(palette.size()))]);
+					candidates.push_back(lane[k]);
+					++res.added;
+				}
+			}
+			holes[l] = npos;
+		}
+		lap(&CascadeProfile::refill);
+		//! </OL>
+	}
+	if (profile) profile->rounds = res.rounds;
+	batch.commit();
 	return res;
 }
 
@@ -277,7 +1222,7 @@ operator<<(std::ostream& os, const Board& obj) {
 	os << "Size: " << obj._size << std::endl;
 	os << "Items: ";
 	for (const auto& it : obj._items)
-		os << "{" << *it << "}, ";
+		if (it) os << "{" << *it << "}, ";
 	os << "Cells: ";
 	for (const auto& it : obj._cells)
 		os << "{" << *it << "}, ";
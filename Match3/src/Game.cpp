@@ -3,10 +3,17 @@
 #include <Match3/Game.hpp>
 
 #include <random>
+#include <stdexcept>
 
 namespace match3 {
 Game::Game(Size size)
-  : _score()
+  : scoreChanged()
+  , movesChanged()
+  , played()
+  , _score()
+  , _moves()
+  , _seed(0)
+  , _lastTurn()
   , _types(std::make_shared<Types>())
   , _board(std::make_shared<Board>(_types)) {
 	_board->resize(std::move(size));
@@ -17,6 +24,16 @@ Game::score() const noexcept {
 	return _score;
 }
 
+std::size_t
+Game::moves() const noexcept {
+	return _moves;
+}
+
+const Game::TurnStats&
+Game::lastTurn() const noexcept {
+	return _lastTurn;
+}
+
 ConstTypesPtr
 Game::types() const noexcept {
 	return _types;
@@ -34,13 +51,16 @@ Game::size() const noexcept {
 
 void
 Game::resize(const Size& size) {
-	_score = 0;
+	_setScore(0);
+	_setMoves(0);
 	_board->resize(size);
 }
 
 void
 Game::clear() noexcept {
-	_score = 0;
+	_setScore(0);
+	_setMoves(0);
+	_lastTurn = TurnStats();
 	_board->clear();
 }
 
@@ -52,13 +72,114 @@ Game::reset() noexcept {
 
 void
 Game::setTypes(const Types& types) {
+	// A single type would match forever.
+	if (types.size() < 2) throw std::runtime_error("Game needs at least 2 types.");
 	reset();
-	_types->addTypes(types.types());
+	// Copy the whole palette so type identifiers are kept.
+	*_types = types;
 }
 
 void
 Game::fillBoard() {
+	std::random_device rd;
+	fillBoard((std::uint64_t(rd()) << 32) | rd());
+}
+
+void
+Game::fillBoard(std::uint64_t seed) {
 	clear();
-	_board->fill();
+	_seed = seed;
+	_board->random().seed(seed);
+	_board->fill(true);
+}
+
+std::uint64_t
+Game::seed() const noexcept {
+	return _seed;
+}
+
+std::uint64_t
+Game::hash() const noexcept {
+	constexpr std::uint64_t kPrime = 1099511628211ULL;
+	std::uint64_t res              = 14695981039346656037ULL;
+
+	auto add = [&res](std::uint8_t byte) {
+		res ^= byte;
+		res *= kPrime;
+	};
+	auto add64 = [&add](std::uint64_t value) {
+		for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+			add(std::uint8_t(value >> (8 * i)));
+		}
+	};
+	// TypeIds are hashed directly, unlike PackedBoard they have no limit.
+	const Board& board = *_board;
+	const Size& size   = board.size();
+	add64(size.x());
+	add64(size.y());
+	add(std::uint8_t(board.gravity()));
+	for (const std::uint64_t word : board.mask()) {
+		add64(word);
+	}
+	for (int j = 0; j < int(size.y()); ++j) {
+		for (int i = 0; i < int(size.x()); ++i) {
+			const ConstCellPtr cell = board.cell({i, j});
+			const ConstItemPtr item = board.item({i, j});
+			add(cell ? _types->id(cell->type.get()) : Type::NoneId);
+			add(item ? _types->id(item->type.get()) : Type::NoneId);
+		}
+	}
+	add64(board.random().state());
+	add64(_score);
+	return res;
+}
+
+Game::TurnResult
+Game::play(const Move& move) {
+	using Clock = std::chrono::steady_clock;
+	TurnResult res;
+	const Clock::time_point before = Clock::now();
+	if (!_board->swap(move.from, move.to)) return res;
+	const Clock::time_point swapped = Clock::now();
+
+	Board::CascadeProfile profile;
+	const Position seeds[]             = {move.from, move.to};
+	const Board::Resolution resolution = _board->resolve(seeds, true, &profile);
+	const Clock::time_point resolved   = Clock::now();
+	const bool deadlock                = !_board->hasMove();
+	const Clock::time_point after      = Clock::now();
+
+	_lastTurn = {.swap     = swapped - before,
+	             .match    = profile.match,
+	             .settle   = profile.settle,
+	             .refill   = profile.refill,
+	             .deadlock = after - resolved,
+	             .removed  = resolution.removed,
+	             .added    = resolution.added,
+	             .rounds   = resolution.rounds};
+	res       = {.removed  = std::uint32_t(resolution.removed),
+	             .added    = std::uint32_t(resolution.added),
+	             .rounds   = std::uint32_t(resolution.rounds),
+	             .points   = std::uint32_t(resolution.removed),
+	             .valid    = true,
+	             .deadlock = deadlock};
+	_setScore(_score + res.points);
+	_setMoves(_moves + 1);
+	played.emit(move);
+	return res;
+}
+
+void
+Game::_setScore(std::size_t score) {
+	if (score == _score) return;
+	_score = score;
+	scoreChanged.emit(_score);
+}
+
+void
+Game::_setMoves(std::size_t moves) {
+	if (moves == _moves) return;
+	_moves = moves;
+	movesChanged.emit(_moves);
 }
 } // namespace match3
@@ -0,0 +1,177 @@
+//! @file
+#include <Match3/Generator.hpp>
+
+#include <Match3/Board.hpp>
+#include <Match3/PackedBoard.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace match3 {
+namespace {
+//! @brief SplitMix64 finalizer, gives unrelated seeds to consecutive attempts.
+std::uint64_t
+mix(std::uint64_t value) noexcept {
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+//! @brief A board kept by a worker.
+struct Kept {
+	//! @brief Attempt which has generated the board.
+	std::uint64_t attempt;
+	//! @brief The board, see @ref PackedBoard::pack.
+	std::vector<std::byte> data;
+};
+
+//! @brief State owned by a worker thread.
+struct Worker {
+	//! @brief Counters of the worker (elapsed is unused).
+	Generator::Stats stats;
+	//! @brief Boards kept by the worker, in attempt order.
+	std::vector<Kept> kept;
+};
+} // namespace
+
+double
+Generator::Stats::boardsPerSecond() const noexcept {
+	if (elapsed.count() <= 0) return 0.;
+	return double(attempts) / std::chrono::duration<double>(elapsed).count();
+}
+
+Generator::Generator(const Types& types, const Size& size)
+  : Generator(types, size, Constraints()) {}
+
+Generator::Generator(const Types& types, const Size& size, Constraints constraints)
+  : _types(std::make_shared<Types>(types))
+  , _size(size)
+  , _constraints(std::move(constraints)) {
+	// A stable board needs 2 types at least.
+	if (_types->size() < 2) {
+		throw std::runtime_error("Generator needs at least 2 types.");
+	}
+	std::vector<double>& shares = _constraints.distribution;
+	if (shares.empty()) return;
+	if (shares.size() != _types->size()) {
+		throw std::runtime_error("Distribution doesn't match the types.");
+	}
+	const double sum = std::accumulate(shares.begin(), shares.end(), 0.);
+	if (!(sum > 0.) || std::any_of(shares.begin(), shares.end(), [](double s) { return s < 0.; })) {
+		throw std::runtime_error("Invalid distribution.");
+	}
+	for (double& share : shares) {
+		share /= sum;
+	}
+}
+
+const Generator::Constraints&
+Generator::constraints() const noexcept {
+	return _constraints;
+}
+
+Generator::Stats
+Generator::run(
+  std::size_t count,
+  std::uint64_t seed,
+  LevelPackWriter& out,
+  std::size_t threads,
+  std::uint64_t maxAttempts) const {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Stats res;
+	if (count == 0) return res;
+	if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+	if (maxAttempts == 0) maxAttempts = 1000 * std::uint64_t(count);
+
+	// Only counters are shared, they don't publish any data thus relaxed is enough.
+	std::atomic<std::uint64_t> next(0);
+	std::atomic<std::size_t> accepted(0);
+	std::vector<Worker> workers(threads);
+	auto work = [this, count, seed, maxAttempts, &next, &accepted](Worker& worker) {
+		BoardPtr board = std::make_shared<Board>(_types);
+		board->resize(_size);
+		const std::size_t cells = _size.x() * _size.y();
+		const std::size_t limit = _constraints.maxMoves == std::numeric_limits<std::size_t>::max()
+		                            ? _constraints.maxMoves
+		                            : _constraints.maxMoves + 1;
+		std::vector<std::size_t> histogram(Type::FirstId + _types->size());
+		while (accepted.load(std::memory_order_relaxed) < count) {
+			const std::uint64_t attempt = next.fetch_add(1, std::memory_order_relaxed);
+			if (attempt >= maxAttempts) break;
+			++worker.stats.attempts;
+			board->random().seed(mix(seed ^ mix(attempt)));
+			// The stable fill leaves no initial match, or gives up after a
+			// bounded number of rounds.
+			try {
+				board->fill(true);
+			} catch (const std::runtime_error&) {
+				++worker.stats.fillRejected;
+				continue;
+			}
+			std::vector<std::byte> data = PackedBoard::pack(*board);
+			if (!_constraints.distribution.empty()) {
+				const PackedBoard view(data);
+				std::fill(histogram.begin(), histogram.end(), 0);
+				for (std::size_t j = 0; j < _size.y(); ++j) {
+					for (std::size_t i = 0; i < _size.x(); ++i) {
+						++histogram[view.item({int(i), int(j)})];
+					}
+				}
+				bool inRange = true;
+				for (std::size_t i = 0; inRange && i < _constraints.distribution.size(); ++i) {
+					const double share = double(histogram[Type::FirstId + i]) / double(cells);
+					inRange = std::abs(share - _constraints.distribution[i]) <= _constraints.tolerance;
+				}
+				if (!inRange) {
+					++worker.stats.distributionRejected;
+					continue;
+				}
+			}
+			const std::size_t moves = board->moveCount(limit);
+			if (moves < _constraints.minMoves || moves > _constraints.maxMoves) {
+				++worker.stats.moveRejected;
+				continue;
+			}
+			++worker.stats.accepted;
+			worker.kept.push_back({attempt, std::move(data)});
+			accepted.fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+	std::vector<std::thread> pool;
+	pool.reserve(threads - 1);
+	for (std::size_t i = 1; i < threads; ++i) {
+		pool.emplace_back(work, std::ref(workers[i]));
+	}
+	work(workers[0]);
+	for (std::thread& thread : pool) {
+		thread.join();
+	}
+
+	// Keeps the boards of the first attempts, whatever the worker which has run them.
+	std::vector<Kept*> kept;
+	for (Worker& worker : workers) {
+		res.attempts += worker.stats.attempts;
+		res.accepted += worker.stats.accepted;
+		res.fillRejected += worker.stats.fillRejected;
+		res.distributionRejected += worker.stats.distributionRejected;
+		res.moveRejected += worker.stats.moveRejected;
+		for (Kept& board : worker.kept) {
+			kept.push_back(&board);
+		}
+	}
+	std::sort(kept.begin(), kept.end(), [](const Kept* lhs, const Kept* rhs) {
+		return lhs->attempt < rhs->attempt;
+	});
+	kept.resize(std::min(kept.size(), count));
+	for (const Kept* board : kept) {
+		out.add(board->data);
+	}
+	res.elapsed = std::chrono::steady_clock::now() - start;
+	return res;
+}
+} // namespace match3
@@ -0,0 +1,281 @@
+//! @file
+#include <Match3/LevelPack.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace match3 {
+namespace {
+//! @brief First bytes of a level pack.
+constexpr std::byte kMagic[4] = {std::byte('M'), std::byte('3'), std::byte('L'), std::byte('P')};
+
+//! @brief Writes an unsigned integer in little endian.
+void
+writeLE(std::byte* out, std::uint64_t value, std::size_t bytes) {
+	for (std::size_t i = 0; i < bytes; ++i) {
+		out[i] = std::byte(value >> (8 * i));
+	}
+}
+
+//! @brief Reads an unsigned integer in little endian.
+std::uint64_t
+readLE(const std::byte* in, std::size_t bytes) {
+	std::uint64_t res = 0;
+	for (std::size_t i = 0; i < bytes; ++i) {
+		res |= std::uint64_t(in[i]) << (8 * i);
+	}
+	return res;
+}
+
+//! @brief Maps a file in memory.
+//! @param[out] mapping Handle of the mapping (Windows only).
+std::span<const std::byte>
+map(const std::string& path, [[maybe_unused]] void*& mapping) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(),
+	                          GENERIC_READ,
+	                          FILE_SHARE_READ,
+	                          nullptr,
+	                          OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL,
+	                          nullptr);
+	if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Can't open " + path + ".");
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < LONGLONG(LevelPack::HeaderSize)) {
+		CloseHandle(file);
+		throw std::runtime_error("Not a level pack: " + path + ".");
+	}
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) throw std::runtime_error("Can't map " + path + ".");
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) {
+		CloseHandle(mapping);
+		throw std::runtime_error("Can't map " + path + ".");
+	}
+	return {static_cast<const std::byte*>(data), std::size_t(size.QuadPart)};
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) throw std::runtime_error("Can't open " + path + ".");
+	struct stat info;
+	if (::fstat(file, &info) != 0 || info.st_size < off_t(LevelPack::HeaderSize)) {
+		::close(file);
+		throw std::runtime_error("Not a level pack: " + path + ".");
+	}
+	void* data = ::mmap(nullptr, std::size_t(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	// The mapping keeps its own reference on the file.
+	::close(file);
+	if (data == MAP_FAILED) throw std::runtime_error("Can't map " + path + ".");
+	return {static_cast<const std::byte*>(data), std::size_t(info.st_size)};
+#endif
+}
+
+//! @brief Unmaps a file mapped by map().
+void
+unmap(std::span<const std::byte> data, [[maybe_unused]] void* mapping) noexcept {
+#ifdef _WIN32
+	UnmapViewOfFile(data.data());
+	CloseHandle(mapping);
+#else
+	::munmap(const_cast<std::byte*>(data.data()), data.size());
+#endif
+}
+} // namespace
+
+LevelPack::LevelPack(const std::string& path)
+  : _data()
+  , _size(0)
+#ifdef _WIN32
+  , _mapping(nullptr)
+#endif
+{
+	void* mapping = nullptr;
+	_data         = map(path, mapping);
+#ifdef _WIN32
+	_mapping = mapping;
+#endif
+	try {
+		for (std::size_t i = 0; i < sizeof(kMagic); ++i) {
+			if (_data[i] != kMagic[i]) throw std::runtime_error("Not a level pack: " + path + ".");
+		}
+		if (readLE(&_data[4], 4) != Version) {
+			throw std::runtime_error("Unsupported level pack version: " + path + ".");
+		}
+		const std::uint64_t size = readLE(&_data[8], 8);
+		if (size >= (_data.size() - HeaderSize) / 8) {
+			throw std::runtime_error("Level pack truncated: " + path + ".");
+		}
+		_size = std::size_t(size);
+		// Checks the offsets once so level() only has to check the index.
+		std::uint64_t previous = HeaderSize + 8 * (size + 1);
+		for (std::size_t i = 0; i <= _size; ++i) {
+			const std::uint64_t offset = _offset(i);
+			if (offset < previous || offset > _data.size()) {
+				throw std::runtime_error("Level pack corrupted: " + path + ".");
+			}
+			previous = offset;
+		}
+	} catch (...) {
+		unmap(_data, mapping);
+		throw;
+	}
+}
+
+LevelPack::~LevelPack() {
+#ifdef _WIN32
+	unmap(_data, _mapping);
+#else
+	unmap(_data, nullptr);
+#endif
+}
+
+std::size_t
+LevelPack::size() const noexcept {
+	return _size;
+}
+
+std::span<const std::byte>
+LevelPack::data() const noexcept {
+	return _data;
+}
+
+PackedBoard
+LevelPack::level(std::size_t index) const {
+	if (index >= _size) throw std::out_of_range("Level index out of range.");
+	const std::uint64_t begin = _offset(index);
+	return PackedBoard(_data.subspan(std::size_t(begin), std::size_t(_offset(index + 1) - begin)));
+}
+
+LevelPack::Iterator
+LevelPack::begin() const noexcept {
+	return Iterator(this, 0);
+}
+
+LevelPack::Iterator
+LevelPack::end() const noexcept {
+	return Iterator(this, _size);
+}
+
+std::uint64_t
+LevelPack::_offset(std::size_t index) const noexcept {
+	return readLE(&_data[HeaderSize + 8 * index], 8);
+}
+
+LevelPack::Cursor::Cursor(const LevelPack& pack) noexcept
+  : _size(pack.size())
+  , _next(0) {}
+
+std::optional<std::size_t>
+LevelPack::Cursor::next() noexcept {
+	// Relaxed is enough, the counter doesn't publish any data.
+	const std::size_t index = _next.fetch_add(1, std::memory_order_relaxed);
+	if (index >= _size) return std::nullopt;
+	return index;
+}
+
+LevelPackWriter::LevelPackWriter()
+  : _levels()
+  , _offsets() {}
+
+void
+LevelPackWriter::add(const Board& board) {
+	add(PackedBoard::pack(board));
+}
+
+void
+LevelPackWriter::add(std::span<const std::byte> level) {
+	// Validates the level.
+	const PackedBoard view(level);
+	_offsets.push_back(_levels.size());
+	_levels.insert(_levels.end(), level.begin(), level.end());
+}
+
+std::size_t
+LevelPackWriter::addText(std::istream& in) {
+	const std::size_t count = size();
+	std::vector<std::string> rows;
+	std::size_t line = 0;
+	// Packs the rows read so far, the first one is the top of the board.
+	auto flush = [this, &rows]() {
+		if (rows.empty()) return;
+		const Size size(rows.front().size(), rows.size());
+		std::vector<TypeId> items(size.x() * size.y(), Type::NoneId);
+		std::vector<std::uint64_t> mask((items.size() + 63) / 64, 0);
+		for (std::size_t j = 0; j < size.y(); ++j) {
+			const std::string& row = rows[size.y() - 1 - j];
+			for (std::size_t i = 0; i < size.x(); ++i) {
+				const std::size_t index = j * size.x() + i;
+				if (row[i] == 'X') continue;
+				mask[index / 64] |= std::uint64_t(1) << (index % 64);
+				if (row[i] != '.') items[index] = TypeId(Type::FirstId + (row[i] - 'a'));
+			}
+		}
+		add(PackedBoard::pack(size, items, {}, Board::Gravity::Down, 0, mask));
+		rows.clear();
+	};
+	for (std::string row; std::getline(in, row);) {
+		++line;
+		if (!row.empty() && row.back() == '\r') row.pop_back();
+		if (!row.empty() && row.front() == '#') continue;
+		if (row.empty()) {
+			flush();
+			continue;
+		}
+		for (char c : row) {
+			if (c != '.' && c != 'X' && (c < 'a' || c >= char('a' + 16 - Type::FirstId))) {
+				throw std::runtime_error("Unknown cell '" + std::string(1, c) + "' at line " +
+				                         std::to_string(line) + ".");
+			}
+		}
+		if (!rows.empty() && row.size() != rows.front().size()) {
+			throw std::runtime_error("Row size mismatch at line " + std::to_string(line) + ".");
+		}
+		rows.push_back(row);
+	}
+	flush();
+	return size() - count;
+}
+
+std::size_t
+LevelPackWriter::size() const noexcept {
+	return _offsets.size();
+}
+
+std::vector<std::byte>
+LevelPackWriter::data() const {
+	const std::size_t start = LevelPack::HeaderSize + 8 * (_offsets.size() + 1);
+	std::vector<std::byte> res(start + _levels.size());
+	std::copy(std::begin(kMagic), std::end(kMagic), res.begin());
+	writeLE(&res[4], LevelPack::Version, 4);
+	writeLE(&res[8], _offsets.size(), 8);
+	for (std::size_t i = 0; i < _offsets.size(); ++i) {
+		writeLE(&res[LevelPack::HeaderSize + 8 * i], start + _offsets[i], 8);
+	}
+	writeLE(&res[start - 8], res.size(), 8);
+	std::copy(_levels.begin(), _levels.end(), res.begin() + std::ptrdiff_t(start));
+	return res;
+}
+
+void
+LevelPackWriter::write(const std::string& path) const {
+	const std::vector<std::byte> bytes = data();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+	if (!file) throw std::runtime_error("Can't write " + path + ".");
+}
+} // namespace match3
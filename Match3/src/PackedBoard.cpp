@@ -0,0 +1,268 @@
+//! @file
+#include <Match3/PackedBoard.hpp>
+
+#include <Match3/Types.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace match3 {
+namespace {
+//! @brief First bytes of a packed board.
+constexpr std::byte kMagic[2] = {std::byte('M'), std::byte('3')};
+//! @brief Flags byte: gravity bits.
+constexpr unsigned kGravityMask = 0x07;
+//! @brief Flags byte: cells use 4 bits.
+constexpr unsigned kWideCells = 0x08;
+//! @brief Flags byte: the cell plane follows the item plane.
+constexpr unsigned kCellPlane = 0x10;
+//! @brief Flags byte: the shape plane follows the other planes.
+constexpr unsigned kShapePlane = 0x20;
+//! @brief Largest width or height.
+constexpr std::size_t kMaxExtent = 0xFFFF;
+
+//! @brief Writes an unsigned integer in little endian.
+void
+writeLE(std::byte* out, std::uint64_t value, std::size_t bytes) {
+	for (std::size_t i = 0; i < bytes; ++i) {
+		out[i] = std::byte(value >> (8 * i));
+	}
+}
+
+//! @brief Reads an unsigned integer in little endian.
+std::uint64_t
+readLE(const std::byte* in, std::size_t bytes) {
+	std::uint64_t res = 0;
+	for (std::size_t i = 0; i < bytes; ++i) {
+		res |= std::uint64_t(in[i]) << (8 * i);
+	}
+	return res;
+}
+
+//! @brief Writes the value of a cell in a plane.
+void
+put(std::byte* plane, std::size_t index, unsigned bits, unsigned value) {
+	const std::size_t bit = index * bits;
+	const unsigned shift  = unsigned(bit % 8);
+	plane[bit / 8] |= std::byte((value << shift) & 0xFF);
+	if (shift + bits > 8) plane[bit / 8 + 1] |= std::byte(value >> (8 - shift));
+}
+
+//! @brief Gets the number of bytes of a plane.
+std::size_t
+planeSize(const Size& size, unsigned bits) {
+	return (size.x() * size.y() * bits + 7) / 8;
+}
+
+//! @brief Checks if a mask blocks a cell.
+bool
+blocked(std::span<const std::uint64_t> mask, std::size_t count) noexcept {
+	for (std::size_t i = 0; i < count; ++i) {
+		if (!((mask[i / 64] >> (i % 64)) & 1)) return true;
+	}
+	return false;
+}
+
+//! @brief Serializes the planes of a board.
+//! @param[in] cells Cell plane, empty to omit it.
+//! @param[in] mask Shape plane, empty to omit it.
+std::vector<std::byte>
+write(
+  const Size& size,
+  std::span<const TypeId> items,
+  std::span<const TypeId> cells,
+  Board::Gravity gravity,
+  std::uint64_t randomState,
+  unsigned bits,
+  std::span<const std::uint64_t> mask) {
+	if (size.x() > kMaxExtent || size.y() > kMaxExtent) {
+		throw std::runtime_error("Board too large to pack.");
+	}
+	const std::size_t count = size.x() * size.y();
+	if (items.size() != count || (!cells.empty() && cells.size() != count) ||
+	    (!mask.empty() && mask.size() != (count + 63) / 64)) {
+		throw std::runtime_error("Buffer size doesn't match the board size.");
+	}
+	if (!mask.empty() && !blocked(mask, count)) mask = {};
+	const std::size_t plane = planeSize(size, bits);
+	const std::size_t start = PackedBoard::HeaderSize;
+	const std::size_t shape = start + (cells.empty() ? 1 : 2) * plane;
+	std::vector<std::byte> res(shape + (mask.empty() ? 0 : planeSize(size, 1)), std::byte(0));
+	res[0] = kMagic[0];
+	res[1] = kMagic[1];
+	res[2] = std::byte(PackedBoard::Version);
+	res[3] = std::byte(unsigned(gravity) | (bits == 4 ? kWideCells : 0) |
+	                   (cells.empty() ? 0 : kCellPlane) | (mask.empty() ? 0 : kShapePlane));
+	writeLE(&res[4], size.x(), 2);
+	writeLE(&res[6], size.y(), 2);
+	writeLE(&res[8], randomState, 8);
+	for (std::size_t index = 0; index < count; ++index) {
+		put(&res[start], index, bits, items[index]);
+		if (!cells.empty()) put(&res[start + plane], index, bits, cells[index]);
+		if (!mask.empty()) put(&res[shape], index, 1, (mask[index / 64] >> (index % 64)) & 1);
+	}
+	return res;
+}
+} // namespace
+
+PackedBoard::PackedBoard(std::span<const std::byte> data)
+  : _data(data) {
+	if (_data.size() < HeaderSize || _data[0] != kMagic[0] || _data[1] != kMagic[1]) {
+		throw std::runtime_error("Not a packed board.");
+	}
+	if (std::uint8_t(_data[2]) != Version) {
+		throw std::runtime_error("Unsupported packed board version.");
+	}
+	if ((unsigned(_data[3]) & kGravityMask) > unsigned(Board::Gravity::None)) {
+		throw std::runtime_error("Invalid packed board gravity.");
+	}
+	if (_data.size() < _maskOffset() + (hasMask() ? planeSize(size(), 1) : 0)) {
+		throw std::runtime_error("Packed board truncated.");
+	}
+}
+
+std::vector<std::byte>
+PackedBoard::pack(const Board& board) {
+	ConstTypesPtr types     = board.types();
+	const std::size_t count = types ? types->size() : 0;
+	if (Type::FirstId + count > 16) throw std::runtime_error("Too many types to pack.");
+	// Same width for all boards of a palette.
+	const unsigned bits = Type::FirstId + count > 8 ? 4 : 3;
+
+	// Gets the TypeId of an item or cell type.
+	auto id = [&types](const Type& type) -> TypeId {
+		if (type.name() == Type::None.name()) return Type::NoneId;
+		const TypeId res = types ? types->id(type) : Type::NoneId;
+		if (res == Type::NoneId) throw std::runtime_error("Type not in the palette.");
+		return res;
+	};
+	const Size& size = board.size();
+	std::vector<TypeId> items(size.x() * size.y(), Type::NoneId);
+	std::vector<TypeId> cells(items.size(), Type::NoneId);
+	bool cellPlane = false;
+	for (std::size_t j = 0; j < size.y(); ++j) {
+		for (std::size_t i = 0; i < size.x(); ++i) {
+			const Position pos{int(i), int(j)};
+			const std::size_t index = j * size.x() + i;
+			if (ConstItemPtr it = board.item(pos)) items[index] = id(it->type.get());
+			cells[index] = id(board.cell(pos)->type.get());
+			cellPlane    = cellPlane || cells[index] != Type::NoneId;
+		}
+	}
+	if (!cellPlane) cells.clear();
+	return write(
+	  size, items, cells, board.gravity(), board.random().state(), bits, board.mask());
+}
+
+std::vector<std::byte>
+PackedBoard::pack(
+  const Size& size,
+  std::span<const TypeId> items,
+  std::span<const TypeId> cells,
+  Board::Gravity gravity,
+  std::uint64_t randomState,
+  std::span<const std::uint64_t> mask) {
+	TypeId maxId = 0;
+	for (TypeId id : items)
+		maxId = std::max(maxId, id);
+	for (TypeId id : cells)
+		maxId = std::max(maxId, id);
+	if (maxId > 15) throw std::runtime_error("Too many types to pack.");
+	return write(size, items, cells, gravity, randomState, maxId > 7 ? 4 : 3, mask);
+}
+
+std::span<const std::byte>
+PackedBoard::data() const noexcept {
+	return _data;
+}
+
+Size
+PackedBoard::size() const noexcept {
+	return Size(readLE(&_data[4], 2), readLE(&_data[6], 2));
+}
+
+Board::Gravity
+PackedBoard::gravity() const noexcept {
+	return Board::Gravity(unsigned(_data[3]) & kGravityMask);
+}
+
+std::uint64_t
+PackedBoard::randomState() const noexcept {
+	return readLE(&_data[8], 8);
+}
+
+unsigned
+PackedBoard::bitsPerCell() const noexcept {
+	return (unsigned(_data[3]) & kWideCells) ? 4 : 3;
+}
+
+bool
+PackedBoard::hasCellTypes() const noexcept {
+	return (unsigned(_data[3]) & kCellPlane) != 0;
+}
+
+bool
+PackedBoard::hasMask() const noexcept {
+	return (unsigned(_data[3]) & kShapePlane) != 0;
+}
+
+TypeId
+PackedBoard::item(const Position& pos) const noexcept {
+	return _read(HeaderSize, pos);
+}
+
+TypeId
+PackedBoard::cell(const Position& pos) const noexcept {
+	if (!hasCellTypes()) return Type::NoneId;
+	return _read(HeaderSize + _planeSize(), pos);
+}
+
+bool
+PackedBoard::playable(const Position& pos) const noexcept {
+	if (!hasMask()) return true;
+	const std::size_t bit = std::size_t(pos.y()) * readLE(&_data[4], 2) + std::size_t(pos.x());
+	return ((unsigned(_data[_maskOffset() + bit / 8]) >> (bit % 8)) & 1) != 0;
+}
+
+void
+PackedBoard::unpack(Board& board) const {
+	const Size size = this->size();
+	std::vector<TypeId> items(size.x() * size.y());
+	std::vector<TypeId> cells(hasCellTypes() ? items.size() : 0);
+	std::vector<std::uint64_t> mask(hasMask() ? (items.size() + 63) / 64 : 0);
+	for (std::size_t j = 0; j < size.y(); ++j) {
+		for (std::size_t i = 0; i < size.x(); ++i) {
+			const Position pos{int(i), int(j)};
+			const std::size_t index = j * size.x() + i;
+			items[index]            = item(pos);
+			if (!cells.empty()) cells[index] = cell(pos);
+			if (!mask.empty() && playable(pos)) mask[index / 64] |= std::uint64_t(1) << (index % 64);
+		}
+	}
+	board.assign(items, size, cells, mask);
+	board.setGravity(gravity());
+	board.random().setState(randomState());
+}
+
+std::size_t
+PackedBoard::_planeSize() const noexcept {
+	return planeSize(size(), bitsPerCell());
+}
+
+std::size_t
+PackedBoard::_maskOffset() const noexcept {
+	return HeaderSize + (hasCellTypes() ? 2 : 1) * _planeSize();
+}
+
+TypeId
+PackedBoard::_read(std::size_t offset, const Position& pos) const noexcept {
+	const unsigned bits    = bitsPerCell();
+	const std::size_t x    = std::size_t(pos.x());
+	const std::size_t y    = std::size_t(pos.y());
+	const std::size_t bit  = (y * readLE(&_data[4], 2) + x) * bits;
+	const std::byte* plane = &_data[offset];
+	const unsigned shift   = unsigned(bit % 8);
+	unsigned value         = unsigned(plane[bit / 8]) >> shift;
+	if (shift + bits > 8) value |= unsigned(plane[bit / 8 + 1]) << (8 - shift);
+	return TypeId(value & ((1u << bits) - 1));
+}
+} // namespace match3
@@ -0,0 +1,196 @@
+//! @file
+#include <Match3/Replay.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace match3 {
+namespace {
+//! @brief First bytes of a replay, followed by the version.
+constexpr std::byte kMagic[3] = {std::byte('M'), std::byte('3'), std::byte('R')};
+//! @brief Version of the layout written by the recorder.
+constexpr std::uint8_t kVersion = 2;
+//! @brief Largest width or height, as PackedBoard.
+constexpr std::uint64_t kMaxExtent = 0xFFFF;
+//! @brief Largest number of cells (e.g. 4096x4096).
+constexpr std::uint64_t kMaxCells = std::uint64_t(1) << 24;
+//! @brief Offset of a neighbour for each direction code.
+const Position kDirections[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+
+//! @brief Appends an unsigned LEB128 varint.
+void
+putVarint(std::vector<std::byte>& out, std::uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(std::byte((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(std::byte(value));
+}
+
+//! @brief Reads a replay sequentially.
+class Reader {
+	public:
+	explicit Reader(std::span<const std::byte> data)
+	  : _data(data)
+	  , _pos(0) {}
+
+	//! @brief Reads an unsigned LEB128 varint.
+	//! @throw std::runtime_error if the data is truncated or the varint overflows.
+	std::uint64_t varint() {
+		std::uint64_t res = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			const std::uint8_t byte = std::uint8_t(this->byte());
+			res |= std::uint64_t(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) return res;
+		}
+		throw std::runtime_error("Replay varint overflow.");
+	}
+	//! @brief Reads one byte.
+	//! @throw std::runtime_error if the data is truncated.
+	std::byte byte() {
+		if (_pos >= _data.size()) throw std::runtime_error("Replay truncated.");
+		return _data[_pos++];
+	}
+	//! @brief Reads several bytes.
+	//! @throw std::runtime_error if the data is truncated.
+	std::span<const std::byte> bytes(std::size_t size) {
+		if (size > _data.size() - _pos) throw std::runtime_error("Replay truncated.");
+		_pos += size;
+		return _data.subspan(_pos - size, size);
+	}
+
+	private:
+	std::span<const std::byte> _data;
+	std::size_t _pos;
+};
+} // namespace
+
+ReplayRecorder::ReplayRecorder(const Game& game)
+  : _game(game)
+  , _header()
+  , _moves()
+  , _count(0)
+  , _connection() {
+	restart();
+	_connection = _game.played.connect([this](const Move& move) { _record(move); });
+}
+
+void
+ReplayRecorder::restart() {
+	if (_game.moves() != 0) {
+		throw std::runtime_error("Replay must start on a new board.");
+	}
+	_header.assign(std::begin(kMagic), std::end(kMagic));
+	_header.push_back(std::byte(kVersion));
+	putVarint(_header, _game.size().x());
+	putVarint(_header, _game.size().y());
+	const std::vector<Type>& palette = _game.types()->palette();
+	putVarint(_header, palette.size());
+	for (const Type& type : palette) {
+		putVarint(_header, type.name().size());
+		for (char c : type.name()) {
+			_header.push_back(std::byte(c));
+		}
+	}
+	putVarint(_header, _game.seed());
+	_moves.clear();
+	_count = 0;
+}
+
+std::size_t
+ReplayRecorder::size() const noexcept {
+	return _count;
+}
+
+std::vector<std::byte>
+ReplayRecorder::data() const {
+	std::vector<std::byte> res;
+	res.reserve(_header.size() + _moves.size() + 24);
+	res.insert(res.end(), _header.begin(), _header.end());
+	putVarint(res, _count);
+	res.insert(res.end(), _moves.begin(), _moves.end());
+	putVarint(res, _game.score());
+	const std::uint64_t hash = _game.hash();
+	for (std::size_t i = 0; i < sizeof(hash); ++i) {
+		res.push_back(std::byte(hash >> (8 * i)));
+	}
+	return res;
+}
+
+void
+ReplayRecorder::_record(const Move& move) {
+	const Position diff     = move.to - move.from;
+	std::uint64_t direction = 0;
+	while (direction < 3 && kDirections[direction] != diff)
+		++direction;
+	const std::uint64_t cell =
+	  std::uint64_t(move.from.y()) * _game.size().x() + std::uint64_t(move.from.x());
+	putVarint(_moves, (cell << 2) | direction);
+	++_count;
+}
+
+ReplayPlayer::ReplayPlayer()
+  : _game() {}
+
+ReplayPlayer::Result
+ReplayPlayer::run(std::span<const std::byte> replay) {
+	Reader reader(replay);
+	for (std::byte magic : kMagic) {
+		if (reader.byte() != magic) throw std::runtime_error("Not a replay.");
+	}
+	if (std::uint8_t(reader.byte()) != kVersion) {
+		throw std::runtime_error("Unsupported replay version.");
+	}
+	const std::uint64_t width  = reader.varint();
+	const std::uint64_t height = reader.varint();
+	// Checked before allocating the board, positions must also fit an int.
+	if (width > kMaxExtent || height > kMaxExtent || width * height > kMaxCells) {
+		throw std::runtime_error("Invalid replay size.");
+	}
+	const Size size(width, height);
+	Types types;
+	const std::uint64_t typeCount = reader.varint();
+	for (std::uint64_t i = 0; i < typeCount; ++i) {
+		const std::span<const std::byte> name = reader.bytes(reader.varint());
+		const char* chars                     = reinterpret_cast<const char*>(name.data());
+		types.addTypes({Type(std::string(chars, name.size()))});
+	}
+	const std::uint64_t seed = reader.varint();
+
+	// Keeps the board and types of the previous run when they match.
+	if (_game.types()->palette() != types.palette()) _game.setTypes(types);
+	if (_game.size() != size) _game.resize(size);
+	_game.fillBoard(seed);
+
+	Result res;
+	const std::uint64_t count = reader.varint();
+	const std::uint64_t cells = std::uint64_t(size.x()) * size.y();
+	for (std::uint64_t i = 0; i < count; ++i) {
+		const std::uint64_t code = reader.varint();
+		if ((code >> 2) >= cells) throw std::runtime_error("Replay move outside the board.");
+		const Position from(int((code >> 2) % size.x()), int((code >> 2) / size.x()));
+		if (!_game.play({from, from + kDirections[code & 3]}).valid) {
+			res.moves = std::size_t(i);
+			res.score = _game.score();
+			res.hash  = _game.hash();
+			return res;
+		}
+	}
+	const std::uint64_t score              = reader.varint();
+	const std::span<const std::byte> bytes = reader.bytes(sizeof(std::uint64_t));
+	std::uint64_t hash                     = 0;
+	for (std::size_t i = 0; i < sizeof(hash); ++i) {
+		hash |= std::uint64_t(bytes[i]) << (8 * i);
+	}
+	res.moves = std::size_t(count);
+	res.score = _game.score();
+	res.hash  = _game.hash();
+	res.valid = res.score == score && res.hash == hash;
+	return res;
+}
+
+const Game&
+ReplayPlayer::game() const noexcept {
+	return _game;
+}
+} // namespace match3
@@ -0,0 +1,554 @@
+//! @file
+#include <Match3/Solver.hpp>
+
+#include <Match3/Random.hpp>
+#include <Match3/Types.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+namespace match3 {
+namespace {
+//! @brief Largest move budget, depths are stored on 8 bits.
+constexpr std::size_t kMaxDepth = 0xFF;
+//! @brief Number of entries of the transposition table (8 MiB).
+constexpr std::size_t kTableSize = std::size_t(1) << 20;
+//! @brief Number of states between two checks of the shared node counter.
+constexpr std::uint64_t kNodeBatch = 256;
+
+//! @brief Checks if two items match, as Type::operator== (Type::Any matches
+//! any item).
+bool
+same(TypeId lhs, TypeId rhs) noexcept {
+	return lhs != Type::NoneId && rhs != Type::NoneId &&
+	       (lhs == rhs || lhs == Type::AnyId || rhs == Type::AnyId);
+}
+
+//! @brief Flat state of a search node.
+struct State {
+	//! @brief Item TypeId of each cell, row major.
+	std::vector<TypeId> cells;
+	//! @brief State of the refill generator.
+	std::uint64_t random = 0;
+	//! @brief Number of goal items left to clear.
+	std::size_t remaining = 0;
+
+	//! @brief Hashes the state (FNV-1a, then a SplitMix64 finalizer).
+	std::uint64_t hash() const noexcept {
+		std::uint64_t res = 0xCBF29CE484222325ULL;
+		auto add          = [&res](std::uint64_t value) {
+			res ^= value;
+			res *= 0x100000001B3ULL;
+		};
+		for (TypeId id : cells)
+			add(id);
+		add(random);
+		add(remaining);
+		res = (res ^ (res >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		res = (res ^ (res >> 27)) * 0x94D049BB133111EBULL;
+		return res ^ (res >> 31);
+	}
+};
+
+//! @brief A state reached by a move.
+struct Child {
+	//! @brief The move played.
+	Move move;
+	//! @brief Number of goal items cleared by the turn.
+	std::size_t goal = 0;
+	//! @brief Number of items cleared by the turn.
+	std::size_t removed = 0;
+	//! @brief The state after the turn.
+	State state;
+};
+
+//! @brief States known to have no solution within a depth, shared by threads.
+//! @details Each entry packs the 56 high bits of the hash with the depth, so a
+//! torn or lost write only costs a search, never a wrong answer.
+class Table {
+	public:
+	Table()
+	  : _entries(kTableSize) {}
+
+	//! @brief Checks if a state has no solution within depth moves.
+	bool failed(std::uint64_t hash, std::size_t depth) const noexcept {
+		const std::uint64_t entry = _entries[hash & (kTableSize - 1)].load(std::memory_order_relaxed);
+		return entry != 0 && (entry >> 8) == (hash >> 8) && (entry & 0xFF) >= depth;
+	}
+	//! @brief Records that a state has no solution within depth moves.
+	void store(std::uint64_t hash, std::size_t depth) noexcept {
+		_entries[hash & (kTableSize - 1)].store((hash & ~std::uint64_t(0xFF)) | depth,
+		                                        std::memory_order_relaxed);
+	}
+
+	private:
+	std::vector<std::atomic<std::uint64_t>> _entries;
+};
+
+//! @brief Plays turns on flat states, mirroring Board::swap and Board::resolve.
+class Simulator {
+	public:
+	Simulator(const Size& size,
+	          std::span<const std::uint64_t> mask,
+	          std::size_t typeCount,
+	          TypeId goal,
+	          bool refill)
+	  : _width(size.x())
+	  , _height(size.y())
+	  , _paths(size, mask, Board::Gravity::Down)
+	  , _typeCount(typeCount)
+	  , _goal(goal)
+	  , _refill(refill)
+	  , _marks(size.x() * size.y(), 0)
+	  , _mark(0)
+	  , _candidates()
+	  , _shifted()
+	  , _removed()
+	  , _holes()
+	  , _lanes()
+	  , _skips(size.x() * size.y(), npos)
+	  , _origins(size.x() * size.y(), npos) {}
+
+	//! @brief Lists the swaps creating a match, in the order of Board::findMove.
+	void moves(std::vector<TypeId>& cells, std::vector<Move>& out) const {
+		out.clear();
+		for (std::size_t j = 0; j < _height; ++j) {
+			for (std::size_t i = 0; i < _width; ++i) {
+				const std::size_t lhs = j * _width + i;
+				if (cells[lhs] == Type::NoneId) continue;
+				for (const bool vertical : {false, true}) {
+					if (vertical ? j + 1 >= _height : i + 1 >= _width) continue;
+					const std::size_t rhs = lhs + (vertical ? _width : 1);
+					// Swapping two items of the same type changes nothing, unlike a
+					// wildcard swapped with another item (see Board::findMove).
+					if (cells[rhs] == Type::NoneId ||
+					    (cells[lhs] == cells[rhs] && cells[lhs] != Type::AnyId))
+						continue;
+					std::swap(cells[lhs], cells[rhs]);
+					if (_hasMatch(cells, lhs) || _hasMatch(cells, rhs)) {
+						out.push_back({_position(lhs), _position(rhs)});
+					}
+					std::swap(cells[lhs], cells[rhs]);
+				}
+			}
+		}
+	}
+
+	//! @brief Plays a move returned by @ref moves.
+	//! @param[out] goal Number of goal items cleared.
+	//! @return Number of items cleared.
+	std::size_t play(State& state, const Move& move, std::size_t& goal) {
+		const std::size_t from = _index(move.from);
+		const std::size_t to   = _index(move.to);
+		std::swap(state.cells[from], state.cells[to]);
+		_candidates.assign({std::uint32_t(from), std::uint32_t(to)});
+		return _resolve(state, goal);
+	}
+
+	private:
+	std::size_t _index(const Position& pos) const noexcept {
+		return std::size_t(pos.y()) * _width + std::size_t(pos.x());
+	}
+	Position _position(std::size_t index) const noexcept {
+		return Position(int(index % _width), int(index / _width));
+	}
+	//! @brief Checks if the item of a cell is part of a run of 3, as Item::hasMatch.
+	bool _hasMatch(const std::vector<TypeId>& cells, std::size_t index) const noexcept {
+		const TypeId type   = cells[index];
+		const std::size_t x = index % _width;
+		const std::size_t y = index / _width;
+		std::size_t count   = 1;
+		for (std::size_t i = x; i > 0 && same(cells[index - (x - i) - 1], type); --i)
+			++count;
+		for (std::size_t i = x + 1; i < _width && same(cells[index + (i - x)], type); ++i)
+			++count;
+		if (count >= 3) return true;
+		count = 1;
+		for (std::size_t j = y; j > 0 && same(cells[index - (y - j + 1) * _width], type); --j)
+			++count;
+		for (std::size_t j = y + 1; j < _height && same(cells[index + (j - y) * _width], type); ++j)
+			++count;
+		return count >= 3;
+	}
+
+	//! @brief Same steps as Board::_resolve, so the refill draws the same items.
+	std::size_t _resolve(State& state, std::size_t& goal) {
+		std::vector<TypeId>& cells = state.cells;
+		Random random(0);
+		random.setState(state.random);
+		std::size_t res = 0;
+		goal            = 0;
+		_shifted.clear();
+		_holes.assign(_paths.laneCount(), npos);
+		while (!_candidates.empty() || !_shifted.empty()) {
+			if (_mark == std::numeric_limits<std::uint32_t>::max()) {
+				std::fill(_marks.begin(), _marks.end(), 0);
+				_mark = 0;
+			}
+			const std::uint32_t mark = ++_mark;
+			_removed.clear();
+			auto take = [&](std::size_t first, std::size_t last, std::size_t step) {
+				if ((last - first) / step + 1 < 3) return;
+				for (std::size_t k = first; k <= last; k += step) {
+					if (_marks[k] == mark) continue;
+					_marks[k] = mark;
+					_removed.push_back(std::uint32_t(k));
+				}
+			};
+			auto check = [&](std::size_t index, bool vertical) {
+				const TypeId type = cells[index];
+				if (type == Type::NoneId) return;
+				const std::size_t x = index % _width;
+				const std::size_t y = index / _width;
+				std::size_t first = index, last = index;
+				for (std::size_t i = x; i > 0 && same(cells[first - 1], type); --i)
+					--first;
+				for (std::size_t i = x + 1; i < _width && same(cells[last + 1], type); ++i)
+					++last;
+				take(first, last, 1);
+				if (!vertical) return;
+				first = last = index;
+				for (std::size_t j = y; j > 0 && same(cells[first - _width], type); --j)
+					first -= _width;
+				for (std::size_t j = y + 1; j < _height && same(cells[last + _width], type); ++j)
+					last += _width;
+				take(first, last, _width);
+			};
+			for (std::uint32_t index : _candidates)
+				check(index, true);
+			for (std::uint32_t index : _shifted)
+				check(index, false);
+			if (_removed.empty()) break;
+			res += _removed.size();
+
+			_lanes.clear();
+			for (std::uint32_t index : _removed) {
+				if (_goal == Type::NoneId || cells[index] == _goal) ++goal;
+				cells[index]           = Type::NoneId;
+				const std::size_t lane = _paths.laneOf(index);
+				if (_holes[lane] == npos) _lanes.push_back(lane);
+				_holes[lane] = std::min<std::size_t>(_holes[lane], _paths.rankOf(index));
+			}
+
+			_candidates.clear();
+			_shifted.clear();
+			for (std::size_t l : _lanes) {
+				const std::span<const std::uint32_t> lane = _paths.lane(l);
+				for (std::size_t k = _holes[l]; k < lane.size(); ++k) {
+					_skips[lane[k]] = _paths.feeder(lane[k]);
+				}
+				for (std::size_t k = _holes[l]; k < lane.size(); ++k) {
+					const std::uint32_t to = lane[k];
+					if (cells[to] != Type::NoneId) continue;
+					std::uint32_t from = _skips[to];
+					while (from != npos && cells[from] == Type::NoneId)
+						from = _skips[from];
+					for (std::uint32_t i = _skips[to]; i != from;) {
+						const std::uint32_t up = _skips[i];
+						_skips[i]              = from;
+						i                      = up;
+					}
+					if (from == npos) continue;
+					cells[to]                 = cells[from];
+					cells[from]               = Type::NoneId;
+					_origins[to]              = from;
+					const std::uint32_t below = _paths.below(to);
+					const bool together       = below != npos && _origins[below] != npos &&
+					                      _origins[below] == _paths.below(from);
+					(together ? _shifted : _candidates).push_back(to);
+				}
+			}
+			for (std::uint32_t index : _candidates)
+				_origins[index] = npos;
+			for (std::uint32_t index : _shifted)
+				_origins[index] = npos;
+
+			for (std::size_t l : _lanes) {
+				if (_refill) {
+					const std::span<const std::uint32_t> lane = _paths.lane(l);
+					for (std::size_t k = _holes[l]; k < lane.size(); ++k) {
+						if (cells[lane[k]] != Type::NoneId) continue;
+						cells[lane[k]] = TypeId(Type::FirstId + random.below(std::uint32_t(_typeCount)));
+						_candidates.push_back(lane[k]);
+					}
+				}
+				_holes[l] = npos;
+			}
+		}
+		state.random = random.state();
+		return res;
+	}
+
+	static constexpr std::uint32_t npos = Board::FallPaths::npos;
+
+	const std::size_t _width;
+	const std::size_t _height;
+	const Board::FallPaths _paths;
+	const std::size_t _typeCount;
+	const TypeId _goal;
+	const bool _refill;
+	std::vector<std::uint32_t> _marks;
+	std::uint32_t _mark;
+	std::vector<std::uint32_t> _candidates;
+	std::vector<std::uint32_t> _shifted;
+	std::vector<std::uint32_t> _removed;
+	std::vector<std::size_t> _holes;
+	std::vector<std::size_t> _lanes;
+	std::vector<std::uint32_t> _skips;
+	std::vector<std::uint32_t> _origins;
+};
+
+//! @brief Depth first search of one thread.
+class Search {
+	public:
+	//! @brief Data shared by the threads of a solve.
+	struct Shared {
+		Table table;
+		std::atomic<std::uint64_t> nodes{0};
+		std::atomic<bool> stop{false};
+		std::uint64_t maxNodes = 0;
+		//! @brief Lowest root child with a solution at the current depth.
+		std::atomic<std::size_t> best{std::numeric_limits<std::size_t>::max()};
+	};
+
+	Search(const Size& size,
+	       std::span<const std::uint64_t> mask,
+	       std::size_t typeCount,
+	       TypeId goal,
+	       bool refill,
+	       std::size_t maxDepth,
+	       Shared& shared)
+	  : path()
+	  , nodes(0)
+	  , _simulator(size, mask, typeCount, goal, refill)
+	  , _goal(goal)
+	  , _refill(refill)
+	  , _shared(shared)
+	  , _levels(maxDepth + 1)
+	  , _moves()
+	  , _root(0)
+	  , _pending(0) {}
+
+	//! @brief Lists the children of a state, best first.
+	std::vector<Child>& expand(const State& state, std::size_t level) {
+		State scratch = state;
+		_simulator.moves(scratch.cells, _moves);
+		std::vector<Child>& children = _levels[level];
+		children.resize(_moves.size());
+		for (std::size_t i = 0; i < _moves.size(); ++i) {
+			Child& child = children[i];
+			child.move   = _moves[i];
+			child.state.cells.assign(state.cells.begin(), state.cells.end());
+			child.state.random    = state.random;
+			child.removed         = _simulator.play(child.state, child.move, child.goal);
+			child.state.remaining = state.remaining - std::min(state.remaining, child.goal);
+		}
+		// Stable, so equal children keep the order of Board::findMove.
+		std::stable_sort(children.begin(), children.end(), [](const Child& lhs, const Child& rhs) {
+			if (lhs.state.remaining != rhs.state.remaining) {
+				return lhs.state.remaining < rhs.state.remaining;
+			}
+			return lhs.removed > rhs.removed;
+		});
+		return children;
+	}
+
+	//! @brief Searches a solution of a root child within depth moves.
+	//! @return true if found, path then holds its moves (after the root one).
+	bool run(const State& state, std::size_t depth, std::size_t root) {
+		path.clear();
+		_root = root;
+		return _dfs(state, depth, 1);
+	}
+
+	//! @brief Adds the states not yet counted to the shared counter.
+	void flush() noexcept {
+		_shared.nodes.fetch_add(_pending, std::memory_order_relaxed);
+		_pending = 0;
+	}
+
+	//! @brief Moves of the last solution found.
+	std::vector<Move> path;
+	//! @brief Number of states searched by this thread.
+	std::uint64_t nodes;
+
+	private:
+	//! @brief Checks if the search of the current root must stop.
+	bool _aborted() const noexcept {
+		return _shared.stop.load(std::memory_order_relaxed) ||
+		       _shared.best.load(std::memory_order_relaxed) < _root;
+	}
+
+	bool _dfs(const State& state, std::size_t depth, std::size_t level) {
+		if (state.remaining == 0) return true;
+		if (depth == 0 || _aborted()) return false;
+		++nodes;
+		if (++_pending == kNodeBatch) {
+			const std::uint64_t total =
+			  _shared.nodes.fetch_add(_pending, std::memory_order_relaxed) + _pending;
+			_pending = 0;
+			if (_shared.maxNodes && total >= _shared.maxNodes) {
+				_shared.stop.store(true, std::memory_order_relaxed);
+				return false;
+			}
+		}
+		// Without refill, there must be enough goal items left on the board.
+		if (!_refill) {
+			const std::size_t left =
+			  _goal == Type::NoneId
+			    ? state.cells.size() - std::size_t(std::count(state.cells.begin(),
+			                                                  state.cells.end(),
+			                                                  Type::NoneId))
+			    : std::size_t(std::count(state.cells.begin(), state.cells.end(), _goal));
+			if (left < state.remaining) return false;
+		}
+		const std::uint64_t hash = state.hash();
+		if (_shared.table.failed(hash, depth)) return false;
+
+		for (const Child& child : expand(state, level)) {
+			path.push_back(child.move);
+			if (_dfs(child.state, depth - 1, level + 1)) return true;
+			path.pop_back();
+			if (_aborted()) return false;
+		}
+		_shared.table.store(hash, depth);
+		return false;
+	}
+
+	Simulator _simulator;
+	const TypeId _goal;
+	const bool _refill;
+	Shared& _shared;
+	//! @brief Children of each level, reused to avoid allocations.
+	std::vector<std::vector<Child>> _levels;
+	std::vector<Move> _moves;
+	//! @brief Index of the root child searched.
+	std::size_t _root;
+	//! @brief States not yet added to the shared counter.
+	std::uint64_t _pending;
+};
+} // namespace
+
+Solver::Solver(const Board& board, Goal goal, bool refill)
+  : _size(board.size())
+  , _cells(board.size().x() * board.size().y(), Type::NoneId)
+  , _mask(board.mask().begin(), board.mask().end())
+  , _typeCount(0)
+  , _random(board.random().state())
+  , _goal(goal)
+  , _refill(refill) {
+	if (board.gravity() != Board::Gravity::Down) {
+		throw std::runtime_error("Gravity direction not supported yet.");
+	}
+	ConstTypesPtr types = board.types();
+	_typeCount          = types ? types->size() : 0;
+	// As Board::resolve, a single type would match forever.
+	if (_refill && _typeCount < 2) throw std::runtime_error("Refill needs at least 2 types.");
+	for (std::size_t j = 0; j < _size.y(); ++j) {
+		for (std::size_t i = 0; i < _size.x(); ++i) {
+			ConstItemPtr it = board.item({int(i), int(j)});
+			if (!it) continue;
+			const TypeId id = types ? types->id(it->type.get()) : Type::NoneId;
+			if (id == Type::NoneId) throw std::runtime_error("Type not in the palette.");
+			_cells[j * _size.x() + i] = id;
+		}
+	}
+}
+
+Solver::Solver(const PackedBoard& level, std::size_t typeCount, Goal goal, bool refill)
+  : _size(level.size())
+  , _cells(level.size().x() * level.size().y(), Type::NoneId)
+  , _mask((_cells.size() + 63) / 64, 0)
+  , _typeCount(typeCount)
+  , _random(level.randomState())
+  , _goal(goal)
+  , _refill(refill) {
+	if (level.gravity() != Board::Gravity::Down) {
+		throw std::runtime_error("Gravity direction not supported yet.");
+	}
+	// As Board::resolve, a single type would match forever.
+	if (_refill && _typeCount < 2) throw std::runtime_error("Refill needs at least 2 types.");
+	for (std::size_t j = 0; j < _size.y(); ++j) {
+		for (std::size_t i = 0; i < _size.x(); ++i) {
+			const std::size_t index = j * _size.x() + i;
+			const TypeId id         = level.item({int(i), int(j)});
+			if (id >= Type::FirstId + _typeCount) throw std::runtime_error("Type not in the palette.");
+			_cells[index] = id;
+			if (level.playable({int(i), int(j)})) _mask[index / 64] |= std::uint64_t(1) << (index % 64);
+		}
+	}
+}
+
+Solver::Result
+Solver::solve(std::size_t maxMoves, std::size_t threads, std::uint64_t maxNodes) const {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	if (maxMoves > kMaxDepth) throw std::runtime_error("Move budget too large.");
+	if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+	Result res;
+	State state;
+	state.cells     = _cells;
+	state.random    = _random;
+	state.remaining = _goal.count;
+	if (state.remaining == 0) {
+		res.solved   = true;
+		res.complete = true;
+		res.elapsed  = std::chrono::steady_clock::now() - start;
+		return res;
+	}
+
+	Search::Shared shared;
+	shared.maxNodes = maxNodes;
+	std::vector<std::unique_ptr<Search>> searches;
+	for (std::size_t i = 0; i < threads; ++i) {
+		searches.push_back(
+		  std::make_unique<Search>(_size, _mask, _typeCount, _goal.type, _refill, maxMoves, shared));
+	}
+	// The first turn is shared among the threads, so it is expanded once.
+	const std::vector<Child> roots = searches.front()->expand(state, 0);
+	std::vector<std::vector<Move>> solutions(roots.size());
+	for (std::size_t depth = 0; depth < maxMoves && !res.solved; ++depth) {
+		std::atomic<std::size_t> next(0);
+		shared.best.store(std::numeric_limits<std::size_t>::max());
+		auto work = [&](Search& search) {
+			for (std::size_t root = next.fetch_add(1); root < roots.size();
+			     root             = next.fetch_add(1)) {
+				if (shared.best.load(std::memory_order_relaxed) < root) break;
+				if (!search.run(roots[root].state, depth, root)) continue;
+				solutions[root] = search.path;
+				// Keeps the lowest root, so the solution doesn't depend on the threads.
+				std::size_t best = shared.best.load();
+				while (root < best && !shared.best.compare_exchange_weak(best, root)) {
+				}
+			}
+			search.flush();
+		};
+		std::vector<std::thread> pool;
+		for (std::size_t i = 1; i < threads; ++i) {
+			pool.emplace_back(work, std::ref(*searches[i]));
+		}
+		work(*searches[0]);
+		for (std::thread& thread : pool) {
+			thread.join();
+		}
+		if (const std::size_t best = shared.best.load(); best < roots.size()) {
+			res.solved = true;
+			res.moves.push_back(roots[best].move);
+			res.moves.insert(res.moves.end(), solutions[best].begin(), solutions[best].end());
+		}
+		if (shared.stop.load()) break;
+	}
+	res.complete = res.solved || !shared.stop.load();
+	// The first turn is a node too.
+	res.nodes = 1;
+	for (const std::unique_ptr<Search>& search : searches) {
+		res.nodes += search->nodes;
+	}
+	res.elapsed = std::chrono::steady_clock::now() - start;
+	return res;
+}
+} // namespace match3
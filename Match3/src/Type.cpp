@@ -10,7 +10,8 @@ const Type Type::None = Type("");
 const Type Type::Any  = Type("*");
 
 Type::Type(std::string name)
-  : _name(std::move(name)) {}
+  : _name(std::move(name))
+  , _kind(_name.empty() ? _Kind::None : _name == "*" ? _Kind::Any : _Kind::Named) {}
 
 const std::string&
 Type::name() const noexcept {
@@ -19,9 +20,9 @@ Type::name() const noexcept {
 
 bool
 Type::operator==(const Type& rhs) const noexcept {
-	return ((_name == rhs._name) ||
-	        (_name == Type::Any.name() && rhs._name != Type::None.name()) ||
-	        (_name != Type::None.name() && rhs._name == Type::Any.name()));
+	if (_kind == _Kind::Any) return rhs._kind != _Kind::None;
+	if (rhs._kind == _Kind::Any) return _kind != _Kind::None;
+	return _name == rhs._name;
 }
 
 bool
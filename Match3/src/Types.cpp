@@ -2,20 +2,29 @@
 
 #include <Match3/Types.hpp>
 #include <exception>
+#include <stdexcept>
 #include <string>
 
 namespace match3 {
 
 Types::Types(const Type& type)
-  : _types() {
+  : _types()
+  , _palette() {
 	addTypes({type});
 }
 
 Types::Types(std::initializer_list<Type> types)
-  : _types(types) {}
+  : _types()
+  , _palette() {
+	for (const Type& type : types) {
+		if (_types.insert(type).second) _palette.push_back(type);
+	}
+	if (_palette.size() > MaxSize) throw std::runtime_error("Too many types.");
+}
 
 Types::Types(const std::unordered_set<Type>& types)
-  : _types() {
+  : _types()
+  , _palette() {
 	addTypes(types);
 }
 
@@ -57,11 +66,46 @@ Types::types() const noexcept {
 void
 Types::clear() noexcept {
 	_types.clear();
+	_palette.clear();
 }
 
 void
-Types::addTypes(const std::unordered_set<Type>& types) noexcept {
-	_types.insert(types.begin(), types.end());
+Types::addTypes(const std::unordered_set<Type>& types) {
+	const std::size_t size = _palette.size();
+	for (const Type& type : types) {
+		if (_types.insert(type).second) _palette.push_back(type);
+	}
+	if (_palette.size() > MaxSize) {
+		// Rollbacks, identifiers past 0xFF would wrap.
+		for (std::size_t i = size; i < _palette.size(); ++i) _types.erase(_palette[i]);
+		_palette.erase(_palette.begin() + std::ptrdiff_t(size), _palette.end());
+		throw std::runtime_error("Too many types.");
+	}
+}
+
+const std::vector<Type>&
+Types::palette() const noexcept {
+	return _palette;
+}
+
+TypeId
+Types::id(const Type& type) const noexcept {
+	// Compare names, Type::operator== would make Type::Any equal to any Type.
+	if (type.name() == Type::None.name()) return Type::NoneId;
+	if (type.name() == Type::Any.name()) return Type::AnyId;
+	for (std::size_t i = 0; i < _palette.size(); ++i) {
+		if (_palette[i].name() == type.name()) return TypeId(Type::FirstId + i);
+	}
+	return Type::NoneId;
+}
+
+const Type&
+Types::type(TypeId id) const {
+	if (id == Type::NoneId) return Type::None;
+	if (id == Type::AnyId) return Type::Any;
+	if (std::size_t(id - Type::FirstId) >= _palette.size())
+		throw std::out_of_range("Unknown type id.");
+	return _palette[id - Type::FirstId];
 }
 
 std::ostream&
@@ -0,0 +1,144 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/Board.hpp>
+#include <Match3/BoardDelta.hpp>
+#include <Match3/Types.hpp>
+#include <vector>
+
+namespace match3 {
+
+TEST_CASE("BoardDelta index", "[BoardDelta]") {
+	BoardDelta delta;
+	delta.size = Size(4, 3);
+	REQUIRE(delta.empty());
+	REQUIRE(delta.index({0, 0}) == 0);
+	REQUIRE(delta.index({3, 0}) == 3);
+	REQUIRE(delta.index({1, 2}) == 9);
+	REQUIRE(delta.position(9) == Position(1, 2));
+	delta.added.push_back({1, Type::FirstId});
+	REQUIRE_FALSE(delta.empty());
+	delta.clear();
+	REQUIRE(delta.empty());
+}
+
+TEST_CASE("Board changed signal", "[BoardDelta]") {
+	TypesPtr types = std::make_shared<Types>(Types{{"a"}, {"b"}, {"c"}});
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({3, 4}));
+
+	std::vector<BoardDelta> deltas;
+	Signal::Connection connection =
+	  board->changed.connect([&deltas](const BoardDelta& delta) { deltas.push_back(delta); });
+	const TypeId a = types->id(Type("a"));
+	const TypeId b = types->id(Type("b"));
+
+	SECTION("Resize") {
+		REQUIRE_NOTHROW(board->resize({4, 4}));
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].operation == BoardDelta::Operation::Resize);
+		CHECK(deltas[0].size == Size(4, 4));
+	}
+	SECTION("Fill then clear") {
+		REQUIRE_NOTHROW(board->fill());
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].operation == BoardDelta::Operation::Fill);
+		REQUIRE(deltas[0].added.size() == 12);
+		for (std::uint32_t i = 0; i < 12; ++i) {
+			CHECK(deltas[0].added[i].cell == i);
+			CHECK(deltas[0].added[i].type >= Type::FirstId);
+		}
+		REQUIRE_NOTHROW(board->fill());
+		REQUIRE(deltas.size() == 2);
+		CHECK(deltas[1].removed.size() == 12);
+		CHECK(deltas[1].added.size() == 12);
+		REQUIRE_NOTHROW(board->clear());
+		REQUIRE(deltas.size() == 3);
+		CHECK(deltas[2].operation == BoardDelta::Operation::Clear);
+		CHECK(deltas[2].removed.size() == 12);
+		CHECK(deltas[2].added.empty());
+		REQUIRE_NOTHROW(board->clear());
+		CHECK(deltas.size() == 3);
+	}
+	SECTION("Add and remove") {
+		REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(1, 2)),
+		                                 std::make_shared<Item>(Type("b"), Position(0, 0))}));
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].operation == BoardDelta::Operation::Add);
+		REQUIRE(deltas[0].added.size() == 2);
+		CHECK(deltas[0].added[0].cell == 0);
+		CHECK(deltas[0].added[0].type == b);
+		CHECK(deltas[0].added[1].cell == 7);
+		CHECK(deltas[0].added[1].type == a);
+
+		REQUIRE(board->removeItems({Position(0, 0), Position(1, 2)}).size() == 2);
+		REQUIRE(deltas.size() == 2);
+		CHECK(deltas[1].operation == BoardDelta::Operation::Removal);
+		CHECK(deltas[1].removed.size() == 2);
+		REQUIRE(board->removeItem(Position(0, 0)) == nullptr);
+		CHECK(deltas.size() == 2);
+	}
+	SECTION("Retype") {
+		REQUIRE_NOTHROW(board->addItem(std::make_shared<Item>(Type("a"), Position(2, 1))));
+		REQUIRE(board->setItemType({2, 1}, Type("b")) != nullptr);
+		REQUIRE(deltas.size() == 2);
+		CHECK(deltas[1].operation == BoardDelta::Operation::Retype);
+		REQUIRE(deltas[1].retyped.size() == 1);
+		CHECK(deltas[1].retyped[0].cell == 5);
+		CHECK(deltas[1].retyped[0].from == a);
+		CHECK(deltas[1].retyped[0].to == b);
+	}
+	SECTION("Settle") {
+		REQUIRE_NOTHROW(board->addItem(std::make_shared<Item>(Type("a"), Position(1, 3))));
+		REQUIRE(board->iterate().size() == 1);
+		REQUIRE(deltas.size() == 2);
+		CHECK(deltas[1].operation == BoardDelta::Operation::Settle);
+		REQUIRE(deltas[1].moved.size() == 1);
+		CHECK(deltas[1].moved[0].from == 10);
+		CHECK(deltas[1].moved[0].to == 7);
+		CHECK(deltas[1].moved[0].type == a);
+	}
+	SECTION("Swap and cascade") {
+		// b a b    <- y = 1
+		// a b a    <- y = 0
+		REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                 std::make_shared<Item>(Type("b"), Position(1, 0)),
+		                                 std::make_shared<Item>(Type("a"), Position(2, 0)),
+		                                 std::make_shared<Item>(Type("b"), Position(0, 1)),
+		                                 std::make_shared<Item>(Type("a"), Position(1, 1)),
+		                                 std::make_shared<Item>(Type("b"), Position(2, 1)),
+		                                 std::make_shared<Item>(Type("c"), Position(1, 2))}));
+		deltas.clear();
+		REQUIRE_FALSE(board->swap({0, 0}, {2, 0}));
+		REQUIRE_FALSE(board->swap({1, 2}, {1, 3}));
+		REQUIRE_FALSE(board->swap({0, 1}, {0, 2}));
+		CHECK(deltas.empty());
+
+		REQUIRE(board->swap({1, 0}, {1, 1}));
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].operation == BoardDelta::Operation::Swap);
+		REQUIRE(deltas[0].moved.size() == 2);
+		CHECK(deltas[0].moved[0].from == 1);
+		CHECK(deltas[0].moved[0].to == 4);
+		CHECK(deltas[0].moved[1].from == 4);
+		CHECK(deltas[0].moved[1].to == 1);
+
+		Board::CascadeProfile profile;
+		REQUIRE(board->cascade(&profile).size() == 6);
+		CHECK(profile.rounds == 1);
+		CHECK(profile.match.count() >= 0);
+		REQUIRE(deltas.size() == 2);
+		CHECK(deltas[1].operation == BoardDelta::Operation::Cascade);
+		CHECK(deltas[1].removed.size() == 6);
+		CHECK(deltas[1].added.empty());
+		REQUIRE(deltas[1].moved.size() == 1);
+		CHECK(deltas[1].moved[0].from == 7);
+		CHECK(deltas[1].moved[0].to == 1);
+		CHECK(board->item({1, 0})->type.get().name() == "c");
+	}
+	SECTION("No recording without observer") {
+		REQUIRE_NOTHROW(connection.disconnect());
+		REQUIRE_NOTHROW(board->fill());
+		CHECK(deltas.empty());
+	}
+}
+} // namespace match3
@@ -2,6 +2,8 @@
 
 #include <Match3/Board.hpp>
 #include <Match3/Types.hpp>
+#include <optional>
+#include <utility>
 
 namespace match3 {
 
@@ -105,6 +107,74 @@ TEST_CASE("Adding Item(s)", "[Board]") {
 		REQUIRE(itemA == board->item(pos));
 		REQUIRE(itemB->board.get().lock() == nullptr);
 	}
+	SECTION("Adding one item outside the board") {
+		REQUIRE_NOTHROW(board->clear());
+		REQUIRE_THROWS_AS(
+		  board->addItem(std::make_shared<Item>(Type("a"), Position(3, 0))), std::runtime_error);
+		REQUIRE_THROWS_AS(
+		  board->addItem(std::make_shared<Item>(Type("a"), Position(0, -1))), std::runtime_error);
+		REQUIRE(board->items().empty());
+	}
+	SECTION("Adding several items with a collision") {
+		REQUIRE_NOTHROW(board->clear());
+		REQUIRE_NOTHROW(board->addItem(std::make_shared<Item>(Type("a"), Position(2, 2))));
+		REQUIRE_THROWS_AS(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                   std::make_shared<Item>(Type("b"), Position(0, 0))}),
+		                  std::runtime_error);
+		REQUIRE_THROWS_AS(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                   std::make_shared<Item>(Type("b"), Position(2, 2))}),
+		                  std::runtime_error);
+		REQUIRE(board->items().size() == 1);
+		REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                 std::make_shared<Item>(Type("b"), Position(1, 0))}));
+		REQUIRE(board->items().size() == 3);
+		REQUIRE(board->item({1, 0})->board.get().lock() == board);
+	}
+}
+
+TEST_CASE("Assigning items", "[Board]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({2, 2}));
+	REQUIRE_NOTHROW(board->fill());
+
+	const TypeId a                  = types->id(Type("a"));
+	const TypeId c                  = types->id(Type("c"));
+	const std::vector<TypeId> items = {a, Type::NoneId, c, c, a, a};
+	const std::vector<TypeId> cells = {Type::NoneId, c, Type::NoneId, Type::NoneId, a, a};
+	std::vector<BoardDelta> deltas;
+	Signal::Connection connection =
+	  board->changed.connect([&deltas](const BoardDelta& delta) { deltas.push_back(delta); });
+	REQUIRE_NOTHROW(board->assign(items, {3, 2}, cells));
+	CHECK(board->size() == Size(3, 2));
+	CHECK(board->items().size() == 5);
+	CHECK_FALSE(board->item({1, 0}));
+	CHECK(board->item({2, 0})->type.get().name() == "c");
+	CHECK(board->item({0, 1})->position.get() == Position(0, 1));
+	CHECK(board->item({0, 1})->board.get().lock() == board);
+	CHECK(board->cell({1, 0})->type.get().name() == "c");
+	CHECK(board->cell({0, 0})->type.get().name() == Type::None.name());
+	REQUIRE(deltas.size() == 1);
+	CHECK(deltas[0].operation == BoardDelta::Operation::Assign);
+	CHECK(deltas[0].added.size() == 5);
+
+	SECTION("Same size") {
+		deltas.clear();
+		REQUIRE_NOTHROW(board->assign(std::vector<TypeId>(6, c), {3, 2}));
+		CHECK(board->items().size() == 6);
+		CHECK(board->cell({1, 0})->type.get().name() == Type::None.name());
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].removed.size() == 5);
+		CHECK(deltas[0].added.size() == 6);
+	}
+	SECTION("Invalid buffers") {
+		const std::vector<TypeId> unknown = {a, TypeId(Type::FirstId + 3), a, a};
+		REQUIRE_THROWS_AS(board->assign(items, {2, 2}), std::runtime_error);
+		REQUIRE_THROWS_AS(board->assign(items, {3, 2}, {cells.data(), 2}), std::runtime_error);
+		REQUIRE_THROWS_AS(board->assign(unknown, {2, 2}), std::out_of_range);
+		CHECK(board->size() == Size(3, 2));
+		CHECK(board->items().size() == 5);
+	}
 }
 
 TEST_CASE("Removing Item(s)", "[Board]") {
@@ -228,6 +298,98 @@ SCENARIO("Matching", "[Board]") {
 	}
 }
 
+TEST_CASE("Moves with a wildcard", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({4, 4}));
+	// c        <- y = 3
+	// b        <- y = 2
+	// a *      <- y = 1
+	// Moving the wildcard to (0, 1) matches it with a, b and c.
+	REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 1)),
+	                                 std::make_shared<Item>(Type::Any, Position(1, 1)),
+	                                 std::make_shared<Item>(Type("b"), Position(0, 2)),
+	                                 std::make_shared<Item>(Type("c"), Position(0, 3))}));
+	CHECK_FALSE(board->hasMatch());
+	CHECK(board->moveCount() == 1);
+	CHECK(board->hasMove());
+	CHECK(board->findMove() == Move{{0, 1}, {1, 1}});
+	CHECK(board->swap({0, 1}, {1, 1}));
+}
+
+TEST_CASE("Wildcard matching", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({5, 5}));
+
+	SECTION("Runs are seen from each item") {
+		// a * b: only the wildcard matches both of its neighbours.
+		REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                 std::make_shared<Item>(Type::Any, Position(1, 0)),
+		                                 std::make_shared<Item>(Type("b"), Position(2, 0))}));
+		CHECK(board->hasMatch());
+		const std::vector<ConstItemPtr> matches = board->getMatches();
+		REQUIRE(matches.size() == 1);
+		CHECK(matches.front() == board->item({1, 0}));
+		// Type::None items never match the wildcard.
+		REQUIRE_NOTHROW(board->setItemType({0, 0}, Type::None));
+		REQUIRE_NOTHROW(board->setItemType({2, 0}, Type::None));
+		CHECK_FALSE(board->hasMatch());
+	}
+	SECTION("Same as Item::hasMatch and Board::swap") {
+		const std::vector<Type> pool = {Type("a"), Type("b"), Type::Any, Type::None};
+		Random random(5);
+		std::size_t stable = 0;
+		for (int round = 0; round < 400; ++round) {
+			std::vector<ItemPtr> layout;
+			for (int j = 0; j < 5; ++j) {
+				for (int i = 0; i < 5; ++i) {
+					// a or b: 1/2, Any: 1/12, None: 1/12, empty: 1/3.
+					const std::size_t pick = random() % 12;
+					if (pick >= 8) continue;
+					const Type& type = pick < 6 ? pool[pick % 2] : pool[pick - 4];
+					layout.push_back(std::make_shared<Item>(type, Position(i, j)));
+				}
+			}
+			auto load = [&board, &layout]() {
+				board->clear();
+				for (const ItemPtr& item : layout) {
+					board->addItem(std::make_shared<Item>(item->type.get(), item->position.get()));
+				}
+			};
+			load();
+			std::vector<ConstItemPtr> matches;
+			for (const ConstItemPtr& item : std::as_const(*board).items()) {
+				if (item->hasMatch()) matches.push_back(item);
+			}
+			CHECK(board->hasMatch() == !matches.empty());
+			CHECK(board->getMatches() == matches);
+			// On a board with a match, Board::swap also keeps swaps of two
+			// items of the same type.
+			if (!matches.empty()) continue;
+			++stable;
+
+			// Tries each swap through the board.
+			std::vector<Move> moves;
+			for (int j = 0; j < 5; ++j) {
+				for (int i = 0; i < 5; ++i) {
+					for (const Position& dir : {Position(1, 0), Position(0, 1)}) {
+						const Position lhs(i, j), rhs = lhs + dir;
+						if (!board->swap(lhs, rhs)) continue;
+						moves.push_back({lhs, rhs});
+						load();
+					}
+				}
+			}
+			CHECK(board->moveCount() == moves.size());
+			CHECK(board->findMove() == (moves.empty() ? std::optional<Move>() : moves.front()));
+		}
+		CHECK(stable >= 20);
+	}
+}
+
 SCENARIO("Fall", "[Board]") {
 	TypesPtr types = std::make_shared<Types>();
 	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}}));
@@ -243,11 +405,19 @@ SCENARIO("Fall", "[Board]") {
 		REQUIRE_NOTHROW(items = board->iterate());
 		REQUIRE(items.empty());
 
-		using Gravity = Board::Gravity;
-		for (const auto& it : {Gravity::Up, Gravity::Left, Gravity::Right, Gravity::None}) {
-			REQUIRE_NOTHROW(board->setGravity(it));
-			REQUIRE_THROWS(items = board->iterate());
-		}
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Left));
+		REQUIRE_NOTHROW(items = board->iterate());
+		REQUIRE(items.empty());
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Up));
+		REQUIRE_NOTHROW(items = board->iterate());
+		REQUIRE(items.size() == 1);
+		CHECK(items.front()->position.get() == Position(0, 1));
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Right));
+		REQUIRE_NOTHROW(items = board->iterate());
+		REQUIRE(items.size() == 1);
+		CHECK(items.front()->position.get() == Position(1, 1));
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::None));
+		REQUIRE_THROWS(items = board->iterate());
 	}
 
 	SECTION("one item at top") {
@@ -269,4 +439,314 @@ SCENARIO("Fall", "[Board]") {
 		REQUIRE(items.empty());
 	}
 }
+
+SCENARIO("Resolve", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({3, 4}));
+	// c        <- y = 2
+	// b a b    <- y = 1
+	// a b a    <- y = 0
+	REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+	                                 std::make_shared<Item>(Type("b"), Position(1, 0)),
+	                                 std::make_shared<Item>(Type("a"), Position(2, 0)),
+	                                 std::make_shared<Item>(Type("b"), Position(0, 1)),
+	                                 std::make_shared<Item>(Type("a"), Position(1, 1)),
+	                                 std::make_shared<Item>(Type("b"), Position(2, 1)),
+	                                 std::make_shared<Item>(Type("c"), Position(0, 2))}));
+	REQUIRE(board->findMove() == Move{{1, 0}, {1, 1}});
+	REQUIRE(board->hasMove());
+	REQUIRE(board->swap({1, 0}, {1, 1}));
+	const std::vector<Position> seeds = {{1, 0}, {1, 1}, {8, 8}};
+	// The refills are the same at each run.
+	board->random().seed(4);
+
+	SECTION("without refill") {
+		Board::CascadeProfile profile;
+		Board::Resolution res;
+		REQUIRE_NOTHROW(res = board->resolve(seeds, false, &profile));
+		CHECK(res.removed == 6);
+		CHECK(res.added == 0);
+		CHECK(res.rounds == 1);
+		CHECK(profile.rounds == 1);
+		REQUIRE(board->items().size() == 1);
+		CHECK(board->item({0, 0})->type.get().name() == "c");
+		CHECK(board->item({0, 2}) == nullptr);
+		CHECK_FALSE(board->hasMove());
+	}
+	SECTION("with refill") {
+		Board::Resolution res;
+		REQUIRE_NOTHROW(res = board->resolve(seeds, true));
+		CHECK(res.removed >= 6);
+		// The 5 cells empty beforehand are refilled as well.
+		CHECK(res.added == res.removed + 5);
+		CHECK(res.rounds >= 1);
+		CHECK(board->items().size() == 12);
+		CHECK_FALSE(board->hasMatch());
+	}
+	SECTION("gravity to the left") {
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Left));
+		Board::Resolution res;
+		REQUIRE_NOTHROW(res = board->resolve(seeds, true));
+		// The first refill completes another run in the 2 lower rows.
+		CHECK(res.removed == 9);
+		CHECK(res.rounds == 2);
+		// Only the rows with holes are refilled, from the left.
+		CHECK(res.added == res.removed);
+		CHECK(board->items().size() == 7);
+		CHECK(board->item({0, 2})->type.get().name() == "c");
+		CHECK(board->item({1, 2}) == nullptr);
+		CHECK(board->item({0, 3}) == nullptr);
+		CHECK_FALSE(board->hasMatch());
+	}
+	SECTION("gravity not supported") {
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::None));
+		REQUIRE_THROWS_AS(board->resolve(seeds, false), std::runtime_error);
+	}
+}
+
+TEST_CASE("Fall paths", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({3, 4}));
+	REQUIRE_NOTHROW(board->setPlayable({1, 1}, false));
+	using Paths = Board::FallPaths;
+
+	SECTION("Down") {
+		const Paths& paths = board->fallPaths();
+		CHECK(paths.gravity() == Board::Gravity::Down);
+		REQUIRE(paths.laneCount() == 3);
+		// Cell 1 is below the blocked cell 4, fed by the cell 3 of column 0.
+		const std::vector<std::uint32_t> lane(paths.lane(0).begin(), paths.lane(0).end());
+		CHECK(lane == std::vector<std::uint32_t>{0, 1, 3, 6, 9});
+		CHECK(paths.lane(1).size() == 2);
+		CHECK(paths.laneOf(1) == 0);
+		CHECK(paths.rankOf(1) == 1);
+		CHECK(paths.feeder(1) == 3);
+		CHECK(paths.feeder(3) == 6);
+		CHECK(paths.feeder(9) == Paths::npos);
+		CHECK(paths.feeder(7) == 10);
+		CHECK(paths.laneOf(4) == Paths::npos);
+		CHECK(paths.feeder(4) == Paths::npos);
+		CHECK(paths.below(3) == 0);
+		CHECK(paths.below(7) == Paths::npos);
+		CHECK(paths.below(1) == Paths::npos);
+		const std::vector<std::uint32_t> order(paths.order().begin(), paths.order().end());
+		CHECK(order == std::vector<std::uint32_t>{0, 2, 1, 3, 5, 6, 7, 8});
+	}
+	SECTION("Rebuilt with the gravity") {
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Right));
+		const Paths& paths = board->fallPaths();
+		CHECK(paths.gravity() == Board::Gravity::Right);
+		REQUIRE(paths.laneCount() == 4);
+		const std::vector<std::uint32_t> lane(paths.lane(0).begin(), paths.lane(0).end());
+		CHECK(lane == std::vector<std::uint32_t>{2, 5, 1, 0});
+		CHECK(paths.lane(1).size() == 1);
+		CHECK(paths.feeder(5) == 1);
+		CHECK(paths.feeder(3) == Paths::npos);
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::None));
+		CHECK(board->fallPaths().laneCount() == 0);
+	}
+	SECTION("Rebuilt with the shape") {
+		REQUIRE_NOTHROW(board->setPlayable({1, 1}, true));
+		CHECK(board->fallPaths().lane(1).size() == 4);
+		CHECK(board->fallPaths().feeder(1) == 4);
+	}
+}
+
+TEST_CASE("Resolve settles as iterate", "[Board]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}}));
+	const Board::Gravity gravities[] = {
+	  Board::Gravity::Down, Board::Gravity::Up, Board::Gravity::Left, Board::Gravity::Right};
+	Random random(9);
+	std::size_t played = 0;
+	for (int round = 0; round < 200; ++round) {
+		// Same board twice, with some blocked cells.
+		BoardPtr lhs = std::make_shared<Board>(types);
+		BoardPtr rhs = std::make_shared<Board>(types);
+		REQUIRE_NOTHROW(lhs->resize({6, 6}));
+		REQUIRE_NOTHROW(rhs->resize({6, 6}));
+		for (int j = 0; j < 6; ++j) {
+			for (int i = 0; i < 6; ++i) {
+				if (random.below(5) != 0) continue;
+				REQUIRE_NOTHROW(lhs->setPlayable({i, j}, false));
+				REQUIRE_NOTHROW(rhs->setPlayable({i, j}, false));
+			}
+		}
+		REQUIRE_NOTHROW(lhs->setGravity(gravities[round % 4]));
+		REQUIRE_NOTHROW(rhs->setGravity(gravities[round % 4]));
+		lhs->random().seed(std::uint64_t(round));
+		rhs->random().seed(std::uint64_t(round));
+		REQUIRE_NOTHROW(lhs->fill(true));
+		REQUIRE_NOTHROW(rhs->fill(true));
+		const std::optional<Move> move = lhs->findMove();
+		if (!move) continue;
+		++played;
+		REQUIRE(lhs->swap(move->from, move->to));
+		REQUIRE(rhs->swap(move->from, move->to));
+
+		const std::vector<Position> seeds = {move->from, move->to};
+		REQUIRE_NOTHROW(lhs->resolve(seeds, false));
+		REQUIRE_NOTHROW(rhs->cascade());
+		for (int j = 0; j < 6; ++j) {
+			for (int i = 0; i < 6; ++i) {
+				ConstItemPtr lhsItem = lhs->item({i, j});
+				ConstItemPtr rhsItem = rhs->item({i, j});
+				REQUIRE(bool(lhsItem) == bool(rhsItem));
+				if (lhsItem) CHECK(lhsItem->type.get().name() == rhsItem->type.get().name());
+			}
+		}
+	}
+	CHECK(played >= 100);
+}
+
+TEST_CASE("Board shape", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({3, 3}));
+	CHECK(board->mask().size() == 1);
+	CHECK(board->mask()[0] == 0x1FF);
+	REQUIRE_NOTHROW(board->setPlayable({1, 1}, false));
+	CHECK(board->mask()[0] == 0x1EF);
+	CHECK_FALSE(board->playable({1, 1}));
+	CHECK(board->playable({1, 2}));
+	CHECK_FALSE(board->playable({3, 0}));
+
+	SECTION("Blocked cells can't hold items") {
+		CHECK_THROWS_WITH(board->addItem(std::make_shared<Item>(Type("a"), Position(1, 1))),
+		                  "Item position blocked.");
+		CHECK_THROWS_WITH(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                   std::make_shared<Item>(Type("a"), Position(1, 1))}),
+		                  "Item position blocked.");
+		CHECK(board->items().empty());
+		const std::vector<TypeId> items(9, types->id(Type("a")));
+		const std::vector<std::uint64_t> mask = {0x1EF};
+		CHECK_THROWS_WITH(board->assign(items, {3, 3}, {}, mask), "Item position blocked.");
+		const std::vector<std::uint64_t> wide = {0x1EF, 0};
+		CHECK_THROWS_WITH(board->setMask(wide), "Mask size doesn't match the board size.");
+	}
+	SECTION("Blocking a cell removes its item") {
+		REQUIRE_NOTHROW(board->addItem(std::make_shared<Item>(Type("a"), Position(0, 0))));
+		std::vector<BoardDelta> deltas;
+		Signal::Connection connection =
+		  board->changed.connect([&deltas](const BoardDelta& delta) { deltas.push_back(delta); });
+		REQUIRE_NOTHROW(board->setPlayable({0, 0}, false));
+		REQUIRE(deltas.size() == 1);
+		CHECK(deltas[0].operation == BoardDelta::Operation::Shape);
+		CHECK(deltas[0].removed.size() == 1);
+		CHECK(board->items().empty());
+		REQUIRE_NOTHROW(board->setMask({}));
+		CHECK(board->mask()[0] == 0x1FF);
+	}
+	SECTION("Fill skips blocked cells") {
+		board->random().seed(3);
+		REQUIRE_NOTHROW(board->fill(true));
+		CHECK(board->items().size() == 8);
+		CHECK(board->item({1, 1}) == nullptr);
+		CHECK_FALSE(board->hasMatch());
+	}
+	SECTION("Items slide around blocked cells") {
+		// d c .    <- y = 2
+		// b X c    <- y = 1
+		// a a a    <- y = 0
+		REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 0)),
+		                                 std::make_shared<Item>(Type("a"), Position(1, 0)),
+		                                 std::make_shared<Item>(Type("a"), Position(2, 0)),
+		                                 std::make_shared<Item>(Type("b"), Position(0, 1)),
+		                                 std::make_shared<Item>(Type("c"), Position(2, 1)),
+		                                 std::make_shared<Item>(Type("b"), Position(0, 2)),
+		                                 std::make_shared<Item>(Type("c"), Position(1, 2))}));
+		const std::vector<Position> seeds = {{0, 0}};
+		SECTION("Resolve") {
+			Board::Resolution res;
+			REQUIRE_NOTHROW(res = board->resolve(seeds, false));
+			CHECK(res.removed == 3);
+			// The lower b falls straight, the upper one slides below the blocked
+			// cell, the c on the blocked cell stays.
+			REQUIRE(board->item({1, 0}));
+			CHECK(board->item({0, 0})->type.get().name() == "b");
+			CHECK(board->item({1, 0})->type.get().name() == "b");
+			CHECK(board->item({2, 0})->type.get().name() == "c");
+			CHECK(board->item({1, 2})->type.get().name() == "c");
+			CHECK(board->items().size() == 4);
+		}
+		SECTION("Iterate") {
+			REQUIRE(board->findandRemoveMatches().size() == 3);
+			std::vector<ItemPtr> items;
+			REQUIRE_NOTHROW(items = board->iterate());
+			// The cell below the blocked one is fed after the straight falls.
+			REQUIRE(items.size() == 3);
+			CHECK(board->item({1, 0}) == nullptr);
+			REQUIRE_NOTHROW(items = board->iterate());
+			REQUIRE(items.size() == 1);
+			CHECK(items.front()->position.get() == Position(1, 0));
+			CHECK(board->item({0, 1}) == nullptr);
+			REQUIRE_NOTHROW(items = board->iterate());
+			CHECK(items.empty());
+		}
+		SECTION("Refill") {
+			board->random().seed(5);
+			REQUIRE_NOTHROW(board->resolve(seeds, true));
+			// No cell is left empty below the blocked one.
+			CHECK(board->items().size() == 8);
+			CHECK_FALSE(board->hasMatch());
+		}
+	}
+	SECTION("Resize makes all cells playable") {
+		REQUIRE_NOTHROW(board->resize({2, 2}));
+		CHECK(board->mask()[0] == 0xF);
+	}
+}
+
+TEST_CASE("Seeded fill", "[Board]") {
+	TypesPtr types = std::make_shared<Types>();
+	REQUIRE_NOTHROW(types->addTypes({{"a"}, {"b"}, {"c"}, {"d"}}));
+	BoardPtr lhs = std::make_shared<Board>(types);
+	BoardPtr rhs = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(lhs->resize({9, 9}));
+	REQUIRE_NOTHROW(rhs->resize({9, 9}));
+	lhs->random().seed(42);
+	rhs->random().seed(42);
+	REQUIRE_NOTHROW(lhs->fill(true));
+	REQUIRE_NOTHROW(rhs->fill(true));
+	CHECK(lhs->random() == rhs->random());
+	CHECK_FALSE(lhs->hasMatch());
+	REQUIRE(lhs->items().size() == 81);
+	for (int j = 0; j < 9; ++j) {
+		for (int i = 0; i < 9; ++i) {
+			REQUIRE(rhs->item({i, j}));
+			CHECK(lhs->item({i, j})->type.get().name() == rhs->item({i, j})->type.get().name());
+		}
+	}
+}
+
+TEST_CASE("Stable fill", "[Board]") {
+	TypesPtr types = std::make_shared<Types>(Type("a"));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({32, 32}));
+	SECTION("A single type can't be stable") {
+		CHECK_THROWS_WITH(board->fill(true), "Stable fill needs at least 2 types.");
+		REQUIRE_NOTHROW(board->fill());
+		std::vector<Position> seeds = {{0, 0}};
+		CHECK_THROWS_WITH(board->resolve(seeds, true), "Refill needs at least 2 types.");
+	}
+	SECTION("Two types") {
+		REQUIRE_NOTHROW(types->addTypes({Type("b")}));
+		for (std::uint64_t seed = 0; seed < 20; ++seed) {
+			board->random().seed(seed);
+			REQUIRE_NOTHROW(board->fill(true));
+			CHECK(board->items().size() == 32 * 32);
+			CHECK_FALSE(board->hasMatch());
+		}
+	}
+	SECTION("Without gravity") {
+		REQUIRE_NOTHROW(types->addTypes({Type("b"), Type("c")}));
+		REQUIRE_NOTHROW(board->setGravity(Board::Gravity::None));
+		REQUIRE_NOTHROW(board->fill(true));
+		CHECK_FALSE(board->hasMatch());
+	}
+}
 } // namespace match3
@@ -21,10 +21,59 @@ TEST_CASE("Game creation", "[Game]") {
 			WHEN("fill game board...") {
 				REQUIRE(game.types()->size() == 0);
 				REQUIRE_THROWS(game.fillBoard());
+				CHECK_THROWS_WITH(game.setTypes(Types({{"a"}})), "Game needs at least 2 types.");
 				REQUIRE_NOTHROW(game.setTypes(Types({{"a"}, {"b"}, {"c"}})));
 				REQUIRE_NOTHROW(game.fillBoard());
+				REQUIRE_FALSE(game.board()->hasMatch());
+				REQUIRE(game.board()->items().size() == 48);
+			}
+			WHEN("an invalid move is played") {
+				REQUIRE_NOTHROW(game.setTypes(Types({{"a"}, {"b"}, {"c"}})));
+				REQUIRE_NOTHROW(game.fillBoard());
+				REQUIRE_FALSE(game.play({{0, 0}, {2, 0}}).valid);
+				REQUIRE_FALSE(game.play({{0, 0}, {-1, 0}}).valid);
+				REQUIRE(game.score() == 0);
+				REQUIRE(game.moves() == 0);
 			}
 		}
 	}
 }
+
+TEST_CASE("Game signals", "[Game]") {
+	Game game({8, 6});
+	game.setTypes(Types({{"a"}, {"b"}, {"c"}}));
+	game.fillBoard(1);
+	std::vector<std::size_t> scores;
+	std::vector<std::size_t> moves;
+	Signal::Connection scoreConnection =
+	  game.scoreChanged.connect([&scores](std::size_t score) { scores.push_back(score); });
+	Signal::Connection movesConnection =
+	  game.movesChanged.connect([&moves](std::size_t move) { moves.push_back(move); });
+
+	REQUIRE_FALSE(game.play({{0, 0}, {2, 0}}).valid);
+	CHECK(scores.empty());
+	CHECK(moves.empty());
+
+	// The board of this seed has a move, play the first one found.
+	const std::optional<Move> move = game.board()->findMove();
+	REQUIRE(move);
+	const Game::TurnResult turn = game.play(*move);
+	REQUIRE(turn.valid);
+	REQUIRE(moves == std::vector<std::size_t>{1});
+	REQUIRE(scores.size() == 1);
+	CHECK(scores.back() == game.score());
+	CHECK(game.score() >= 3);
+	CHECK(turn.points == game.score());
+	CHECK(turn.added == turn.removed);
+	CHECK(turn.rounds >= 1);
+	CHECK(turn.deadlock == !game.board()->hasMove());
+	CHECK(game.lastTurn().removed == game.score());
+	// The board is refilled and stable.
+	CHECK(game.board()->items().size() == 48);
+	CHECK_FALSE(game.board()->hasMatch());
+
+	game.clear();
+	CHECK(moves.back() == 0);
+	CHECK(scores.back() == 0);
+}
 } // namespace match3
@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/Generator.hpp>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <utility>
+
+namespace match3 {
+
+TEST_CASE("Board move count", "[Generator]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}, {"d"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({4, 4}));
+	// Only swapping (0,0) and (1,0) completes the "a" column, empty cells
+	// can't be swapped.
+	REQUIRE_NOTHROW(board->addItems({
+	  std::make_shared<Item>(Type("b"), Position(0, 0)),
+	  std::make_shared<Item>(Type("a"), Position(1, 0)),
+	  std::make_shared<Item>(Type("a"), Position(0, 1)),
+	  std::make_shared<Item>(Type("a"), Position(0, 2)),
+	}));
+	CHECK(board->moveCount() == 1);
+	CHECK(board->moveCount(0) == 0);
+	REQUIRE_NOTHROW(board->fill(true));
+	const std::size_t moves = board->moveCount();
+	CHECK((moves > 0) == board->hasMove());
+	CHECK(board->moveCount(1) == std::min<std::size_t>(moves, 1));
+}
+
+TEST_CASE("Generator constraints", "[Generator]") {
+	const Types types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}});
+	Generator::Constraints constraints;
+	constraints.minMoves     = 5;
+	constraints.maxMoves     = 20;
+	constraints.distribution = {1, 1, 1, 1, 1};
+	constraints.tolerance    = 0.08;
+	const Generator generator(types, {9, 9}, constraints);
+	CHECK(std::abs(generator.constraints().distribution[0] - 0.2) < 1e-9);
+
+	LevelPackWriter writer;
+	const Generator::Stats stats = generator.run(20, 42, writer, 3);
+	CHECK(writer.size() == 20);
+	CHECK(stats.accepted >= 20);
+	CHECK(stats.fillRejected == 0);
+	CHECK(stats.attempts ==
+	      stats.accepted + stats.fillRejected + stats.distributionRejected + stats.moveRejected);
+
+	const std::string path =
+	  (std::filesystem::temp_directory_path() / "Match3_Generator_UT.m3lp").string();
+	REQUIRE_NOTHROW(writer.write(path));
+	{
+		TypesPtr palette = std::make_shared<Types>(types);
+		BoardPtr board   = std::make_shared<Board>(palette);
+		const LevelPack pack(path);
+		for (const PackedBoard level : pack) {
+			REQUIRE_NOTHROW(level.unpack(*board));
+			CHECK_FALSE(board->hasMatch());
+			CHECK(board->moveCount() >= 5);
+			CHECK(board->moveCount() <= 20);
+			std::size_t count = 0;
+			for (const ConstItemPtr& item : std::as_const(*board).items()) {
+				count += item->type.get().name() == "a";
+			}
+			CHECK(std::abs(double(count) / 81. - 0.2) <= 0.08);
+		}
+	}
+	std::remove(path.c_str());
+}
+
+TEST_CASE("Generator determinism", "[Generator]") {
+	const Types types({{"a"}, {"b"}, {"c"}, {"d"}});
+	const Generator generator(types, {7, 7});
+	LevelPackWriter lhs;
+	LevelPackWriter rhs;
+	generator.run(16, 7, lhs, 1);
+	generator.run(16, 7, rhs, 4);
+	CHECK(lhs.data() == rhs.data());
+	LevelPackWriter other;
+	generator.run(16, 8, other, 4);
+	CHECK(lhs.data() != other.data());
+}
+
+TEST_CASE("Generator gives up", "[Generator]") {
+	const Types types({{"a"}, {"b"}, {"c"}});
+	CHECK_THROWS_AS(Generator(Types(), {5, 5}), std::runtime_error);
+	CHECK_THROWS_WITH(Generator(Types({{"a"}}), {5, 5}), "Generator needs at least 2 types.");
+	Generator::Constraints constraints;
+	constraints.distribution = {1, 1};
+	CHECK_THROWS_AS(Generator(types, {5, 5}, constraints), std::runtime_error);
+
+	constraints.distribution = {1, 0, 0};
+	constraints.tolerance    = 0.01;
+	const Generator generator(types, {5, 5}, constraints);
+	LevelPackWriter writer;
+	const Generator::Stats stats = generator.run(3, 1, writer, 2, 50);
+	CHECK(writer.size() == 0);
+	CHECK(stats.attempts == 50);
+	CHECK(stats.distributionRejected == 50);
+	CHECK(stats.boardsPerSecond() > 0.);
+}
+} // namespace match3
@@ -0,0 +1,158 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/LevelPack.hpp>
+#include <Match3/Types.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+
+namespace match3 {
+
+namespace {
+//! @brief Gets the path of a temporary file.
+std::string
+tempPath(const std::string& name) {
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+} // namespace
+
+TEST_CASE("LevelPack round trip", "[LevelPack]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}}));
+	LevelPackWriter writer;
+	std::vector<std::vector<std::byte>> levels;
+	for (int i = 0; i < 10; ++i) {
+		BoardPtr board = std::make_shared<Board>(types);
+		REQUIRE_NOTHROW(board->resize({std::size_t(5 + i), 9}));
+		REQUIRE_NOTHROW(board->fill(true));
+		levels.push_back(PackedBoard::pack(*board));
+		REQUIRE_NOTHROW(writer.add(*board));
+	}
+	CHECK(writer.size() == 10);
+	CHECK_THROWS_AS(writer.add(std::vector<std::byte>(4)), std::runtime_error);
+
+	const std::string path = tempPath("Match3_LevelPack_UT.m3lp");
+	REQUIRE_NOTHROW(writer.write(path));
+	{
+		const LevelPack pack(path);
+		REQUIRE(pack.size() == 10);
+		CHECK(pack.data().size() == writer.data().size());
+		std::size_t index = 0;
+		for (const PackedBoard level : pack) {
+			CHECK(std::vector<std::byte>(level.data().begin(), level.data().end()) ==
+			      levels[index]);
+			CHECK(level.size() == Size(5 + index, 9));
+			++index;
+		}
+		CHECK(index == 10);
+		CHECK_THROWS_AS(pack.level(10), std::out_of_range);
+
+		BoardPtr board = std::make_shared<Board>(types);
+		REQUIRE_NOTHROW(pack.level(3).unpack(*board));
+		CHECK(PackedBoard::pack(*board) == levels[3]);
+	}
+	std::remove(path.c_str());
+}
+
+TEST_CASE("LevelPack invalid files", "[LevelPack]") {
+	CHECK_THROWS_AS(LevelPack(tempPath("Match3_LevelPack_UT.missing")), std::runtime_error);
+
+	const std::string path = tempPath("Match3_LevelPack_UT.bad");
+	LevelPackWriter writer;
+	std::istringstream text("ab\nba\n");
+	REQUIRE(writer.addText(text) == 1);
+	std::vector<std::byte> data = writer.data();
+	SECTION("Magic") {
+		data[0] = std::byte('X');
+	}
+	SECTION("Truncated") {
+		data.resize(LevelPack::HeaderSize + 8);
+	}
+	SECTION("Offsets") {
+		data[LevelPack::HeaderSize + 8] = std::byte(0xFF);
+	}
+	{
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		REQUIRE(file);
+		std::fwrite(data.data(), 1, data.size(), file);
+		std::fclose(file);
+	}
+	CHECK_THROWS_AS(LevelPack(path), std::runtime_error);
+	std::remove(path.c_str());
+}
+
+TEST_CASE("LevelPack text grid", "[LevelPack]") {
+	LevelPackWriter writer;
+	std::istringstream text("# first\n"
+	                        "abc\n"
+	                        "bXa\n"
+	                        ".ab\n"
+	                        "\n"
+	                        "\n"
+	                        "aabba\r\n"
+	                        "nnnn.\r\n");
+	REQUIRE(writer.addText(text) == 2);
+
+	const std::string path = tempPath("Match3_LevelPack_UT.text");
+	REQUIRE_NOTHROW(writer.write(path));
+	{
+		const LevelPack pack(path);
+		REQUIRE(pack.size() == 2);
+		const PackedBoard first = pack.level(0);
+		CHECK(first.size() == Size(3, 3));
+		CHECK(first.bitsPerCell() == 3);
+		CHECK(first.item({0, 0}) == Type::NoneId);
+		CHECK(first.item({1, 0}) == Type::FirstId);
+		CHECK(first.item({2, 2}) == Type::FirstId + 2);
+		CHECK(first.hasMask());
+		CHECK_FALSE(first.playable({1, 1}));
+		CHECK(first.item({1, 1}) == Type::NoneId);
+		const PackedBoard second = pack.level(1);
+		CHECK(second.size() == Size(5, 2));
+		CHECK(second.bitsPerCell() == 4);
+		CHECK(second.item({0, 0}) == 15);
+		CHECK(second.item({4, 0}) == Type::NoneId);
+		CHECK(second.item({4, 1}) == Type::FirstId);
+		CHECK_FALSE(second.hasMask());
+	}
+	std::remove(path.c_str());
+
+	std::istringstream mismatch("abc\nab\n");
+	CHECK_THROWS_WITH(writer.addText(mismatch), "Row size mismatch at line 2.");
+	std::istringstream unknown("abc\nabz\n");
+	CHECK_THROWS_WITH(writer.addText(unknown), "Unknown cell 'z' at line 2.");
+}
+
+TEST_CASE("LevelPack cursor", "[LevelPack]") {
+	LevelPackWriter writer;
+	for (int i = 0; i < 1000; ++i) {
+		std::istringstream text("ab\nba\n");
+		writer.addText(text);
+	}
+	const std::string path = tempPath("Match3_LevelPack_UT.cursor");
+	REQUIRE_NOTHROW(writer.write(path));
+	{
+		const LevelPack pack(path);
+		LevelPack::Cursor cursor(pack);
+		std::vector<std::atomic<int>> seen(pack.size());
+		std::vector<std::thread> workers;
+		for (int i = 0; i < 4; ++i) {
+			workers.emplace_back([&]() {
+				while (std::optional<std::size_t> index = cursor.next()) {
+					if (pack.level(*index).item({0, 0}) == Type::FirstId + 1) ++seen[*index];
+				}
+			});
+		}
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		CHECK(std::all_of(seen.begin(), seen.end(), [](const std::atomic<int>& n) {
+			return n == 1;
+		}));
+		CHECK_FALSE(cursor.next());
+	}
+	std::remove(path.c_str());
+}
+} // namespace match3
@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/Board.hpp>
+#include <Match3/PackedBoard.hpp>
+#include <Match3/Types.hpp>
+
+namespace match3 {
+
+TEST_CASE("PackedBoard round trip", "[PackedBoard]") {
+	TypesPtr types = std::make_shared<Types>(Types{{"a"}, {"b"}, {"c"}, {"d"}, {"e"}});
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({9, 9}));
+	board->random().seed(42);
+	REQUIRE_NOTHROW(board->fill(true));
+	REQUIRE_NOTHROW(board->removeItem(Position(4, 8)));
+
+	std::vector<std::byte> data;
+	REQUIRE_NOTHROW(data = PackedBoard::pack(*board));
+	CHECK(data.size() < 64);
+
+	const PackedBoard view(data);
+	CHECK(view.data().data() == data.data());
+	CHECK(view.size() == Size(9, 9));
+	CHECK(view.gravity() == Board::Gravity::Down);
+	CHECK(view.randomState() == board->random().state());
+	CHECK(view.bitsPerCell() == 3);
+	CHECK_FALSE(view.hasCellTypes());
+	for (int j = 0; j < 9; ++j) {
+		for (int i = 0; i < 9; ++i) {
+			const ConstItemPtr it = board->item({i, j});
+			CHECK(view.item({i, j}) == (it ? types->id(it->type.get()) : Type::NoneId));
+		}
+	}
+
+	SECTION("unpack") {
+		BoardPtr copy = std::make_shared<Board>(types);
+		REQUIRE_NOTHROW(view.unpack(*copy));
+		CHECK(copy->size() == board->size());
+		CHECK(copy->random() == board->random());
+		CHECK(copy->items().size() == 80);
+		CHECK(PackedBoard::pack(*copy) == data);
+	}
+	SECTION("invalid data") {
+		std::vector<std::byte> bad = data;
+		bad[0]                     = std::byte('X');
+		CHECK_THROWS_AS(PackedBoard(bad), std::runtime_error);
+		bad    = data;
+		bad[2] = std::byte(PackedBoard::Version + 1);
+		CHECK_THROWS_AS(PackedBoard(bad), std::runtime_error);
+		bad = data;
+		bad.pop_back();
+		CHECK_THROWS_AS(PackedBoard(bad), std::runtime_error);
+	}
+}
+
+TEST_CASE("PackedBoard layouts", "[PackedBoard]") {
+	TypesPtr types = std::make_shared<Types>();
+	for (int i = 0; i < 8; ++i) {
+		REQUIRE_NOTHROW(types->addTypes({Type("t" + std::to_string(i))}));
+	}
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({9, 9}));
+	REQUIRE_NOTHROW(board->fill());
+	REQUIRE_NOTHROW(board->setGravity(Board::Gravity::Left));
+	REQUIRE_NOTHROW(board->cell({2, 3})->type.set(Type("t7")));
+
+	const std::vector<std::byte> data = PackedBoard::pack(*board);
+	const PackedBoard view(data);
+	CHECK(view.bitsPerCell() == 4);
+	CHECK(view.hasCellTypes());
+	CHECK(view.gravity() == Board::Gravity::Left);
+	CHECK(view.cell({2, 3}) == types->id(Type("t7")));
+	CHECK(view.cell({3, 2}) == Type::NoneId);
+	CHECK(view.item({8, 8}) == types->id(board->item({8, 8})->type.get()));
+
+	BoardPtr copy = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(view.unpack(*copy));
+	CHECK(copy->cell({2, 3})->type.get().name() == "t7");
+	CHECK(PackedBoard::pack(*copy) == data);
+
+	CHECK_FALSE(view.hasMask());
+	CHECK(view.playable({4, 4}));
+	REQUIRE_NOTHROW(board->setPlayable({4, 4}, false));
+	const std::vector<std::byte> shaped = PackedBoard::pack(*board);
+	// One more plane of 81 bits.
+	CHECK(shaped.size() == data.size() + 11);
+	const PackedBoard shape(shaped);
+	CHECK(shape.hasMask());
+	CHECK_FALSE(shape.playable({4, 4}));
+	CHECK(shape.playable({4, 5}));
+	REQUIRE_NOTHROW(shape.unpack(*copy));
+	CHECK_FALSE(copy->playable({4, 4}));
+	CHECK(copy->item({4, 4}) == nullptr);
+	CHECK(PackedBoard::pack(*copy) == shaped);
+	CHECK_THROWS_AS(PackedBoard(std::span(shaped).first(shaped.size() - 1)), std::runtime_error);
+
+	REQUIRE_NOTHROW(types->addTypes({{"x"}, {"y"}, {"z"}, {"w"}, {"v"}, {"u"}, {"s"}}));
+	CHECK_THROWS_AS(PackedBoard::pack(*board), std::runtime_error);
+}
+} // namespace match3
@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/Replay.hpp>
+
+namespace match3 {
+
+namespace {
+//! @brief Plays up to count moves, the first found each time.
+void
+playMoves(Game& game, std::size_t count) {
+	for (std::size_t i = 0; i < count; ++i) {
+		const std::optional<Move> move = game.board()->findMove();
+		if (!move) return;
+		REQUIRE(game.play(*move).valid);
+	}
+}
+} // namespace
+
+TEST_CASE("Seeded game", "[Replay]") {
+	Game lhs({9, 9});
+	Game rhs({9, 9});
+	lhs.setTypes(Types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}}));
+	rhs.setTypes(Types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}}));
+	lhs.fillBoard(1234);
+	rhs.fillBoard(1234);
+	CHECK(lhs.seed() == 1234);
+	CHECK(lhs.hash() == rhs.hash());
+	playMoves(lhs, 10);
+	playMoves(rhs, 10);
+	CHECK(lhs.score() == rhs.score());
+	CHECK(lhs.hash() == rhs.hash());
+	rhs.fillBoard(4321);
+	CHECK(lhs.hash() != rhs.hash());
+
+	// Unlike PackedBoard, the hash doesn't limit the number of types.
+	Types many;
+	for (char name = 'a'; name <= 'p'; ++name)
+		many.addTypes({Type(std::string(1, name))});
+	rhs.setTypes(many);
+	rhs.fillBoard(1234);
+	CHECK_NOTHROW(rhs.hash());
+	CHECK(lhs.hash() != rhs.hash());
+}
+
+TEST_CASE("Replay record and play", "[Replay]") {
+	Game game({9, 9});
+	game.setTypes(Types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}}));
+	game.fillBoard(42);
+	ReplayRecorder recorder(game);
+	playMoves(game, 20);
+	REQUIRE(recorder.size() == game.moves());
+	const std::vector<std::byte> data = recorder.data();
+	// Header, about one byte per move then the score and the hash.
+	CHECK(data.size() < 40 + 2 * recorder.size());
+
+	ReplayPlayer player;
+	ReplayPlayer::Result result = player.run(data);
+	CHECK(result.valid);
+	CHECK(result.moves == game.moves());
+	CHECK(result.score == game.score());
+	CHECK(result.hash == game.hash());
+	// The player reuses its game.
+	CHECK(player.run(data).valid);
+
+	SECTION("tampered score") {
+		std::vector<std::byte> bad = data;
+		bad[bad.size() - 9]        = std::byte(std::uint8_t(bad[bad.size() - 9]) ^ 1);
+		CHECK_FALSE(player.run(bad).valid);
+	}
+	SECTION("invalid data") {
+		std::vector<std::byte> bad = data;
+		bad[0]                     = std::byte('X');
+		CHECK_THROWS_AS(player.run(bad), std::runtime_error);
+		bad = data;
+		bad.resize(bad.size() - 4);
+		CHECK_THROWS_AS(player.run(bad), std::runtime_error);
+		// Sizes are checked before allocating the board.
+		auto header = [&data](std::initializer_list<std::uint8_t> size) {
+			std::vector<std::byte> res(data.begin(), data.begin() + 4);
+			for (std::uint8_t byte : size)
+				res.push_back(std::byte(byte));
+			return res;
+		};
+		// 2^28 x 1, then 4096 x 4097.
+		CHECK_THROWS_WITH(player.run(header({0x80, 0x80, 0x80, 0x80, 0x01, 0x01})),
+		                  "Invalid replay size.");
+		CHECK_THROWS_WITH(player.run(header({0x80, 0x20, 0x81, 0x20})), "Invalid replay size.");
+	}
+	SECTION("restart") {
+		CHECK_THROWS_AS(recorder.restart(), std::runtime_error);
+		game.fillBoard(7);
+		REQUIRE_NOTHROW(recorder.restart());
+		CHECK(recorder.size() == 0);
+		playMoves(game, 5);
+		result = player.run(recorder.data());
+		CHECK(result.valid);
+		CHECK(result.score == game.score());
+	}
+}
+} // namespace match3
@@ -0,0 +1,152 @@
+#include <catch2/catch_all.hpp>
+
+#include <Match3/Solver.hpp>
+#include <Match3/Types.hpp>
+#include <vector>
+
+namespace match3 {
+namespace {
+//! @brief Plays moves as Game::play does, returns the number of items removed.
+std::size_t
+replay(Board& board, const std::vector<Move>& moves, bool refill) {
+	std::size_t res = 0;
+	for (const Move& move : moves) {
+		REQUIRE(board.swap(move.from, move.to));
+		const Position seeds[] = {move.from, move.to};
+		res += board.resolve(seeds, refill).removed;
+	}
+	return res;
+}
+} // namespace
+
+TEST_CASE("Solver without refill", "[Solver]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({8, 1}));
+	// a a b a c c b c: swapping (2,0) and (3,0) clears 3 "a", swapping (6,0)
+	// and (7,0) clears 3 "c", no other move clears anything.
+	const std::string row = "aabaccbc";
+	for (int i = 0; i < 8; ++i) {
+		REQUIRE_NOTHROW(
+		  board->addItem(std::make_shared<Item>(Type(std::string(1, row[i])), Position(i, 0))));
+	}
+	const std::vector<Move> expected = {{{2, 0}, {3, 0}}, {{6, 0}, {7, 0}}};
+
+	SECTION("Optimal solution") {
+		const Solver solver(*board, {Type::NoneId, 6}, false);
+		const Solver::Result res = solver.solve(5);
+		CHECK(res.solved);
+		CHECK(res.complete);
+		CHECK(res.moves == expected);
+		CHECK(res.nodes > 0);
+		CHECK(replay(*board, res.moves, false) == 6);
+	}
+	SECTION("Proof of failure") {
+		const Solver solver(*board, {Type::NoneId, 6}, false);
+		const Solver::Result res = solver.solve(1);
+		CHECK_FALSE(res.solved);
+		CHECK(res.complete);
+		CHECK(res.moves.empty());
+		// Only 8 items are on the board.
+		const Solver::Result none = Solver(*board, {Type::NoneId, 9}, false).solve(10);
+		CHECK_FALSE(none.solved);
+		CHECK(none.complete);
+	}
+	SECTION("Goal type") {
+		const Solver::Result res = Solver(*board, {types->id(Type("c")), 3}, false).solve(5);
+		CHECK(res.solved);
+		CHECK(res.moves == std::vector<Move>{expected[1]});
+		const Solver::Result none = Solver(*board, {types->id(Type("b")), 1}, false).solve(5);
+		CHECK_FALSE(none.solved);
+		CHECK(none.complete);
+	}
+	SECTION("Reached goal") {
+		const Solver::Result res = Solver(*board, {Type::NoneId, 0}, false).solve(5);
+		CHECK(res.solved);
+		CHECK(res.moves.empty());
+	}
+	SECTION("Packed level") {
+		const std::vector<std::byte> data = PackedBoard::pack(*board);
+		const Solver solver(PackedBoard(data), types->size(), {Type::NoneId, 6}, false);
+		CHECK(solver.solve(5).moves == expected);
+		CHECK_THROWS_WITH(Solver(PackedBoard(data), 1, {Type::NoneId, 6}, false),
+		                  "Type not in the palette.");
+	}
+	SECTION("Invalid") {
+		CHECK_THROWS_WITH(Solver(*board, {Type::NoneId, 6}, true).solve(256),
+		                  "Move budget too large.");
+		board->setGravity(Board::Gravity::Up);
+		CHECK_THROWS_WITH(Solver(*board, {Type::NoneId, 6}, false),
+		                  "Gravity direction not supported yet.");
+	}
+}
+
+TEST_CASE("Solver with a wildcard", "[Solver]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({4, 4}));
+	// c        <- y = 3
+	// b        <- y = 2
+	// a *      <- y = 1
+	// Only moving the wildcard to (0, 1) clears it with b and c.
+	REQUIRE_NOTHROW(board->addItems({std::make_shared<Item>(Type("a"), Position(0, 1)),
+	                                 std::make_shared<Item>(Type::Any, Position(1, 1)),
+	                                 std::make_shared<Item>(Type("b"), Position(0, 2)),
+	                                 std::make_shared<Item>(Type("c"), Position(0, 3))}));
+	const Solver::Result res = Solver(*board, {Type::NoneId, 3}, false).solve(3);
+	CHECK(res.solved);
+	CHECK(res.moves == std::vector<Move>{{{0, 1}, {1, 1}}});
+	CHECK(replay(*board, res.moves, false) == 3);
+}
+
+TEST_CASE("Solver with refill", "[Solver]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}, {"d"}, {"e"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({6, 6}));
+	board->random().seed(7);
+	REQUIRE_NOTHROW(board->fill(true));
+	const Solver solver(*board, {Type::NoneId, 20}, true);
+
+	const Solver::Result res = solver.solve(5);
+	REQUIRE(res.solved);
+	CHECK(res.complete);
+	REQUIRE(res.moves.size() > 1);
+	const Solver::Result shorter = solver.solve(res.moves.size() - 1);
+	CHECK_FALSE(shorter.solved);
+	CHECK(shorter.complete);
+	// Same solution whatever the number of threads.
+	CHECK(solver.solve(5, 4).moves == res.moves);
+	// Within the node limit the search can't complete.
+	CHECK_FALSE(Solver(*board, {Type::NoneId, 1000}, true).solve(5, 2, 1).complete);
+	CHECK_THROWS_WITH(Solver(PackedBoard(PackedBoard::pack(*board)), 1, {Type::NoneId, 20}, true),
+	                  "Refill needs at least 2 types.");
+
+	// The refill draws the same items as the board, so the score is reached
+	// on the last move only.
+	const std::vector<Move> first(res.moves.begin(), res.moves.end() - 1);
+	BoardPtr copy = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(PackedBoard(PackedBoard::pack(*board)).unpack(*copy));
+	CHECK(replay(*copy, first, true) < 20);
+	CHECK(replay(*board, res.moves, true) >= 20);
+}
+
+TEST_CASE("Solver with blocked cells", "[Solver]") {
+	TypesPtr types = std::make_shared<Types>(Types({{"a"}, {"b"}, {"c"}, {"d"}}));
+	BoardPtr board = std::make_shared<Board>(types);
+	REQUIRE_NOTHROW(board->resize({6, 6}));
+	for (const Position& pos : {Position(0, 0), Position(2, 2), Position(3, 2), Position(5, 5)}) {
+		REQUIRE_NOTHROW(board->setPlayable(pos, false));
+	}
+	board->random().seed(11);
+	REQUIRE_NOTHROW(board->fill(true));
+
+	// Items slide around the blocked cells as on the board.
+	const Solver::Result res = Solver(*board, {Type::NoneId, 25}, true).solve(6);
+	REQUIRE(res.solved);
+	const std::vector<std::byte> data = PackedBoard::pack(*board);
+	CHECK(Solver(PackedBoard(data), types->size(), {Type::NoneId, 25}, true).solve(6).moves ==
+	      res.moves);
+	CHECK(replay(*board, res.moves, true) >= 25);
+	CHECK(board->item({2, 2}) == nullptr);
+}
+} // namespace match3
@@ -1,6 +1,7 @@
 #include <catch2/catch_all.hpp>
 
 #include <Match3/Types.hpp>
+#include <string>
 using match3::Type;
 using match3::Types;
 
@@ -104,3 +105,42 @@ TEST_CASE("Types Management", "[Types]") {
 		}
 	}
 }
+
+TEST_CASE("Types identifiers", "[Types]") {
+	Types types = {{"a"}, {"b"}, {"c"}};
+	REQUIRE(types.palette().size() == 3);
+	REQUIRE(types.id(Type::None) == Type::NoneId);
+	REQUIRE(types.id(Type::Any) == Type::AnyId);
+	REQUIRE(types.id(Type("a")) == Type::FirstId);
+	REQUIRE(types.id(Type("c")) == Type::FirstId + 2);
+	REQUIRE(types.id(Type("z")) == Type::NoneId);
+	for (const Type& type : types.palette()) {
+		REQUIRE(types.type(types.id(type)).name() == type.name());
+	}
+	REQUIRE(types.type(Type::AnyId).name() == Type::Any.name());
+	REQUIRE_THROWS_AS(types.type(Type::FirstId + 3), std::out_of_range);
+
+	WHEN("Adding an existing type") {
+		REQUIRE_NOTHROW(types.addTypes({Type("b"), Type("d")}));
+		THEN("identifiers are kept") {
+			REQUIRE(types.palette().size() == 4);
+			REQUIRE(types.id(Type("b")) == Type::FirstId + 1);
+			REQUIRE(types.id(Type("d")) == Type::FirstId + 3);
+		}
+	}
+}
+
+TEST_CASE("Types limit", "[Types]") {
+	Types types;
+	for (std::size_t i = 0; i < Types::MaxSize; ++i) {
+		types.addTypes({Type("t" + std::to_string(i))});
+	}
+	REQUIRE(types.size() == Types::MaxSize);
+	REQUIRE(types.id(types.palette().back()) == 0xFF);
+	REQUIRE_NOTHROW(types.addTypes({Type("t0")}));
+
+	CHECK_THROWS_WITH(types.addTypes({Type("t0"), Type("u")}), "Too many types.");
+	REQUIRE(types.size() == Types::MaxSize);
+	REQUIRE(types.id(Type("u")) == Type::NoneId);
+	REQUIRE(types.id(Type("t0")) == Type::FirstId);
+}
@@ -0,0 +1,126 @@
+//! @file
+//! @brief Generates starting boards to a level pack.
+//! @details usage: Match3_generate [--size WxH] [--types N] [--count N]
+//! [--moves MIN:MAX] [--distribution W,W,...] [--tolerance T] [--seed N]
+//! [--threads N] [--max-attempts N] [--output FILE]
+//!
+//! Boards have no initial match, a number of legal moves in [MIN, MAX] and, if
+//! a distribution is given (one weight per type), the share of each type is
+//! within the tolerance of its weight. See match3::Generator.
+//! At least 2 types are needed for a board without match.
+//! Defaults: 9x9 boards of 5 types with at least one move, 1000 boards written
+//! to generated.m3lp.
+#include <Match3/Generator.hpp>
+#include <Match3/LevelPack.hpp>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+//! @brief Splits a string at each separator.
+std::vector<std::string>
+split(const std::string& value, char separator) {
+	std::vector<std::string> res(1);
+	for (char c : value) {
+		if (c == separator) {
+			res.emplace_back();
+		} else {
+			res.back() += c;
+		}
+	}
+	return res;
+}
+
+//! @brief Prints a rejection counter with its rate.
+void
+report(const std::string& name, std::uint64_t count, std::uint64_t attempts) {
+	std::cerr << std::left << std::setw(16) << name << std::right << std::setw(12) << count << " ("
+	          << std::fixed << std::setprecision(2)
+	          << (attempts ? 100. * double(count) / double(attempts) : 0.) << "%)" << std::endl;
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+	try {
+		match3::Size size(9, 9);
+		std::size_t typeCount     = 5;
+		std::size_t count         = 1000;
+		std::uint64_t seed        = 0;
+		std::size_t threads       = 0;
+		std::uint64_t maxAttempts = 0;
+		std::string output        = "generated.m3lp";
+		match3::Generator::Constraints constraints;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << std::endl;
+				return 2;
+			}
+			const std::string value = argv[++i];
+			if (arg == "--size") {
+				const std::vector<std::string> dims = split(value, 'x');
+				if (dims.size() != 2) throw std::invalid_argument("Invalid size " + value);
+				size = match3::Size(std::stoul(dims[0]), std::stoul(dims[1]));
+			} else if (arg == "--types") {
+				typeCount = std::stoul(value);
+				if (typeCount < 2) throw std::invalid_argument("At least 2 types are needed");
+			} else if (arg == "--count") {
+				count = std::stoul(value);
+			} else if (arg == "--moves") {
+				const std::vector<std::string> range = split(value, ':');
+				if (range.size() != 2) throw std::invalid_argument("Invalid move range " + value);
+				constraints.minMoves = std::stoul(range[0]);
+				if (!range[1].empty()) constraints.maxMoves = std::stoul(range[1]);
+			} else if (arg == "--distribution") {
+				constraints.distribution.clear();
+				for (const std::string& weight : split(value, ',')) {
+					constraints.distribution.push_back(std::stod(weight));
+				}
+			} else if (arg == "--tolerance") {
+				constraints.tolerance = std::stod(value);
+			} else if (arg == "--seed") {
+				seed = std::stoull(value);
+			} else if (arg == "--threads") {
+				threads = std::stoul(value);
+			} else if (arg == "--max-attempts") {
+				maxAttempts = std::stoull(value);
+			} else if (arg == "--output") {
+				output = value;
+			} else {
+				std::cerr << "Unknown option " << arg << std::endl;
+				return 2;
+			}
+		}
+
+		match3::Types types;
+		for (std::size_t i = 0; i < typeCount; ++i) {
+			types.addTypes({match3::Type("t" + std::to_string(i))});
+		}
+		const match3::Generator generator(types, size, constraints);
+		match3::LevelPackWriter writer;
+		const match3::Generator::Stats stats =
+		  generator.run(count, seed, writer, threads, maxAttempts);
+		writer.write(output);
+
+		std::cerr << output << ": " << writer.size() << " board(s)" << std::endl;
+		std::cerr << std::left << std::setw(16) << "attempts" << std::right << std::setw(12)
+		          << stats.attempts << " in " << std::fixed << std::setprecision(3)
+		          << std::chrono::duration<double>(stats.elapsed).count() << " s ("
+		          << std::setprecision(0) << stats.boardsPerSecond() << " boards/s)" << std::endl;
+		report("accepted", stats.accepted, stats.attempts);
+		report("fill", stats.fillRejected, stats.attempts);
+		report("distribution", stats.distributionRejected, stats.attempts);
+		report("moves", stats.moveRejected, stats.attempts);
+		if (writer.size() < count) {
+			std::cerr << "Gave up after " << stats.attempts << " attempts" << std::endl;
+			return 1;
+		}
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
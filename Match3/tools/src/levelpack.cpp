@@ -0,0 +1,89 @@
+//! @file
+//! @brief Converts text grids to a level pack, or prints a pack as text.
+//! @details usage: Match3_levelpack [--output FILE] TEXT...
+//! Match3_levelpack --dump PACK
+//!
+//! See match3::LevelPackWriter::addText for the text format, the pack is
+//! written to levels.m3lp by default.
+#include <Match3/LevelPack.hpp>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+//! @brief Prints the levels of a pack in the text format.
+void
+dump(const std::string& path) {
+	const match3::LevelPack pack(path);
+	bool first = true;
+	for (const match3::PackedBoard level : pack) {
+		if (!first) std::cout << '\n';
+		first = false;
+		const match3::Size size = level.size();
+		for (std::size_t j = size.y(); j-- > 0;) {
+			std::string row(size.x(), '.');
+			for (std::size_t i = 0; i < size.x(); ++i) {
+				const match3::TypeId id = level.item({int(i), int(j)});
+				if (!level.playable({int(i), int(j)})) {
+					row[i] = 'X';
+				} else if (id != match3::Type::NoneId) {
+					row[i] = char('a' + (id - match3::Type::FirstId));
+				}
+			}
+			std::cout << row << '\n';
+		}
+	}
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+	try {
+		std::string output = "levels.m3lp";
+		std::vector<std::string> inputs;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if ((arg == "--output" || arg == "--dump") && i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << std::endl;
+				return 2;
+			}
+			if (arg == "--dump") {
+				dump(argv[i + 1]);
+				return 0;
+			} else if (arg == "--output") {
+				output = argv[++i];
+			} else {
+				inputs.push_back(arg);
+			}
+		}
+		if (inputs.empty()) {
+			std::cerr << "usage: " << argv[0] << " [--output FILE] TEXT...\n"
+			          << "       " << argv[0] << " --dump PACK" << std::endl;
+			return 2;
+		}
+
+		match3::LevelPackWriter writer;
+		for (const std::string& input : inputs) {
+			std::ifstream file(input);
+			if (!file) {
+				std::cerr << "Can't open " << input << std::endl;
+				return 1;
+			}
+			try {
+				const std::size_t count = writer.addText(file);
+				std::cerr << input << ": " << count << " level(s)" << std::endl;
+			} catch (const std::exception& e) {
+				std::cerr << input << ": " << e.what() << std::endl;
+				return 1;
+			}
+		}
+		writer.write(output);
+		std::cerr << output << ": " << writer.size() << " level(s)" << std::endl;
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,102 @@
+//! @file
+//! @brief Checks that the levels of a pack can be solved.
+//! @details usage: Match3_solve [--types N] [--goal COUNT[:TYPE]] [--moves K]
+//! [--refill] [--threads N] [--max-nodes N] PACK
+//!
+//! Searches, for each level, the shortest sequence of at most K moves clearing
+//! COUNT items (of TYPE, `a` to `n`, if given), see match3::Solver. Prints one
+//! line per level: the moves of the solution (`x,y-x,y`), or `none` if there is no
+//! solution, or `unknown` if the node limit has been reached.
+//! Defaults: 5 types, 30 items to clear within 5 moves without refill.
+//! Returns 1 if a level has no solution.
+#include <Match3/LevelPack.hpp>
+#include <Match3/Solver.hpp>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+int
+main(int argc, char** argv) {
+	try {
+		std::size_t typeCount  = 5;
+		std::size_t maxMoves   = 5;
+		std::size_t threads    = 0;
+		std::uint64_t maxNodes = 0;
+		bool refill            = false;
+		std::string input;
+		match3::Solver::Goal goal{match3::Type::NoneId, 30};
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			if (arg == "--refill") {
+				refill = true;
+				continue;
+			}
+			if (arg.rfind("--", 0) != 0) {
+				input = arg;
+				continue;
+			}
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << std::endl;
+				return 2;
+			}
+			const std::string value = argv[++i];
+			if (arg == "--types") {
+				typeCount = std::stoul(value);
+			} else if (arg == "--goal") {
+				const std::size_t colon = value.find(':');
+				goal.count              = std::stoul(value.substr(0, colon));
+				if (colon != std::string::npos) {
+					const std::string type = value.substr(colon + 1);
+					if (type.size() != 1 || type[0] < 'a' || type[0] > 'n') {
+						throw std::invalid_argument("Invalid goal type " + type);
+					}
+					goal.type = match3::TypeId(match3::Type::FirstId + (type[0] - 'a'));
+				}
+			} else if (arg == "--moves") {
+				maxMoves = std::stoul(value);
+			} else if (arg == "--threads") {
+				threads = std::stoul(value);
+			} else if (arg == "--max-nodes") {
+				maxNodes = std::stoull(value);
+			} else {
+				std::cerr << "Unknown option " << arg << std::endl;
+				return 2;
+			}
+		}
+		if (input.empty()) {
+			std::cerr << "Missing level pack" << std::endl;
+			return 2;
+		}
+
+		const match3::LevelPack pack(input);
+		std::size_t unsolvable = 0;
+		std::size_t unknown    = 0;
+		for (std::size_t i = 0; i < pack.size(); ++i) {
+			const match3::Solver solver(pack.level(i), typeCount, goal, refill);
+			const match3::Solver::Result res = solver.solve(maxMoves, threads, maxNodes);
+			std::cout << "level " << i << ": ";
+			if (res.solved) {
+				for (const match3::Move& move : res.moves) {
+					std::cout << move.from.x() << "," << move.from.y() << "-" << move.to.x() << ","
+					          << move.to.y() << " ";
+				}
+			} else if (res.complete) {
+				std::cout << "none ";
+				++unsolvable;
+			} else {
+				std::cout << "unknown ";
+				++unknown;
+			}
+			std::cout << "(" << res.nodes << " nodes, " << std::fixed << std::setprecision(3)
+			          << std::chrono::duration<double>(res.elapsed).count() << " s)" << std::endl;
+		}
+		std::cerr << input << ": " << pack.size() << " level(s), " << unsolvable
+		          << " without solution, " << unknown << " unknown" << std::endl;
+		if (unsolvable) return 1;
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,164 @@
+//! @file
+//! @brief Match3App rendering benchmarks, results are written as JSON.
+//! @details usage: Match3App_bench [--quick] [--warmup N] [--repetitions N]
+//! [--filter NAME] [--output FILE] [--baseline FILE] [--threshold RATIO]
+//! [--budget-ms MS]
+//!
+//! Runs without display using the Qt offscreen platform (unless QT_QPA_PLATFORM
+//! is already set). For each board size and render mode it measures:
+//! - rebuild: BoardView::onBoardReset(),
+//! - fill: Board::fill() including the incremental view update,
+//! - paint: a synchronous repaint of the whole view,
+//! - turn: a swap and its cascade including the view update and a repaint,
+//! then records the process peak memory.
+#include "BoardView.hpp"
+#include "GameWidget.hpp"
+#include "SpriteCache.hpp"
+#include <Bench.hpp>
+#include <Match3/Board.hpp>
+#include <Match3/Types.hpp>
+#include <QApplication>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace match3;
+
+namespace {
+
+//! @brief Runs a benchmark if a single probe run fits in the budget.
+//! @return false if the probe run is over budget.
+bool
+measure(
+  bench::Runner& runner,
+  const std::string& name,
+  const std::function<void()>& setup,
+  const std::function<void()>& body,
+  std::chrono::milliseconds budget) {
+	if (!runner.selected(name)) return true;
+	setup();
+	const bench::Clock::time_point before = bench::Clock::now();
+	body();
+	if (bench::Clock::now() - before > budget) {
+		runner.skip(name, "over budget");
+		return false;
+	}
+	runner.run(name, 1, setup, body);
+	return true;
+}
+
+//! @brief Gets the process peak resident memory in KiB, 0 if unknown.
+double
+peakMemory() {
+#if defined(__APPLE__)
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return double(usage.ru_maxrss) / 1024.; // bytes on macOS
+#elif defined(__unix__)
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return double(usage.ru_maxrss); // KiB on Linux
+#else
+	return 0.;
+#endif
+}
+
+//! @brief Swaps the first pair of items which creates a match.
+//! @return false if there is no such pair.
+bool
+playSwap(Board& board) {
+	const int width  = int(board.size().x());
+	const int height = int(board.size().y());
+	for (int j = 0; j < height; ++j) {
+		for (int i = 0; i < width; ++i) {
+			if (i + 1 < width && board.swap({i, j}, {i + 1, j})) return true;
+			if (j + 1 < height && board.swap({i, j}, {i, j + 1})) return true;
+		}
+	}
+	return false;
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+	if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+	QApplication app(argc, argv);
+
+	bench::Runner runner("Match3App", bench::Options::parse(argc, argv));
+	const bool quick = runner.options().quick;
+	std::chrono::milliseconds budget(quick ? 500 : 2000);
+	const std::vector<std::string>& extra = runner.options().extra;
+	for (std::size_t i = 0; i + 1 < extra.size(); ++i) {
+		if (extra[i] == "--budget-ms") budget = std::chrono::milliseconds(std::stol(extra[i + 1]));
+	}
+
+	std::vector<std::size_t> sizes = {8, 16, 32, 64, 128};
+	if (quick) sizes = {8, 16};
+
+	TypesPtr types = std::make_shared<Types>(Types{{"pkm_1"}, {"pkm_2"}, {"pkm_3"}});
+
+	// Whole game screen, as shown by the application.
+	{
+		GameWidget game;
+		game.resize(480, 800);
+		game.show();
+		QApplication::processEvents();
+		measure(
+		  runner, "game/paint", []() {}, [&]() { game.repaint(); }, budget);
+	}
+
+	const std::vector<std::pair<std::string, BoardView::RenderMode>> modes = {
+	  {"items", BoardView::RenderMode::Items}, {"single", BoardView::RenderMode::Single}};
+	for (const auto& [modeName, mode] : modes) {
+		BoardPtr board = std::make_shared<Board>(types);
+		BoardView view(board);
+		view.setRenderMode(mode);
+		view.resize(800, 800);
+		view.show();
+		QApplication::processEvents();
+
+		bool overBudget = false;
+		for (std::size_t n : sizes) {
+			const std::string suffix = "/" + modeName + "/" + std::to_string(n) + "x" + std::to_string(n);
+			if (overBudget) {
+				for (const char* op : {"rebuild", "fill", "paint", "turn"}) {
+					runner.skip(op + suffix, "smaller size over budget");
+				}
+				continue;
+			}
+			board->resize(Size(n, n));
+			board->fill();
+			QApplication::processEvents();
+			// Sprites at the new tile size are rasterized by a worker thread.
+			SpriteCache::instance().wait();
+			QApplication::processEvents();
+
+			overBudget |= !measure(
+			  runner, "rebuild" + suffix, []() {}, [&]() { view.onBoardReset(); }, budget);
+			overBudget |= !measure(
+			  runner, "fill" + suffix, []() {}, [&]() { board->fill(); }, budget);
+			overBudget |= !measure(
+			  runner, "paint" + suffix, []() { QApplication::processEvents(); },
+			  [&]() { view.viewport()->repaint(); }, budget);
+			overBudget |= !measure(
+			  runner, "turn" + suffix,
+			  [&]() {
+				  // Untimed: a fresh and stable board.
+				  board->fill();
+				  board->cascade();
+				  QApplication::processEvents();
+			  },
+			  [&]() {
+				  if (playSwap(*board)) board->cascade();
+				  view.viewport()->repaint();
+			  },
+			  budget);
+			runner.metric("peak_memory" + suffix, peakMemory(), "KiB");
+		}
+	}
+	return runner.report();
+}
@@ -0,0 +1,134 @@
+//! @file
+
+#include "BoardAnimator.hpp"
+
+#include <QTimerEvent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+//! @brief Timeline period in milliseconds (i.e. ~60 fps).
+constexpr int kFrameInterval = 16;
+} // namespace
+
+BoardAnimator::BoardAnimator(QObject* parent)
+  : QObject(parent)
+  , _duration(150)
+  , _easing(QEasingCurve::InQuad)
+  , _clock()
+  , _timerId(0)
+  , _tracks() {}
+
+BoardAnimator::~BoardAnimator() {
+	finish();
+}
+
+int
+BoardAnimator::duration() const noexcept {
+	return _duration;
+}
+
+void
+BoardAnimator::setDuration(int msec) {
+	_duration = std::max(0, msec);
+}
+
+void
+BoardAnimator::setEasingCurve(const QEasingCurve& easing) {
+	_easing = easing;
+}
+
+void
+BoardAnimator::move(QGraphicsItem* item, const QPointF& from, const QPointF& to) {
+	const QPointF diff    = to - from;
+	const qreal distance  = std::sqrt(diff.x() * diff.x() + diff.y() * diff.y());
+	const qint64 duration = qint64(_duration * std::sqrt(std::max<qreal>(distance, 1.0)));
+	_add({item, Kind::Move, from, to, 0, duration});
+}
+
+void
+BoardAnimator::fadeIn(QGraphicsItem* item) {
+	_add({item, Kind::FadeIn, item->pos(), item->pos(), 0, _duration});
+}
+
+void
+BoardAnimator::fadeOut(QGraphicsItem* item) {
+	_add({item, Kind::FadeOut, item->pos(), item->pos(), 0, _duration});
+}
+
+bool
+BoardAnimator::isRunning() const noexcept {
+	return !_tracks.empty();
+}
+
+void
+BoardAnimator::finish() {
+	for (const Track& track : _tracks) {
+		_apply(track, 1.0);
+	}
+	_tracks.clear();
+	if (_timerId != 0) {
+		killTimer(_timerId);
+		_timerId = 0;
+		Q_EMIT finished();
+	}
+}
+
+void
+BoardAnimator::timerEvent(QTimerEvent* event) {
+	if (event->timerId() != _timerId) {
+		QObject::timerEvent(event);
+		return;
+	}
+	const qint64 now = _clock.elapsed();
+	// Swap and pop finished tracks, order doesn't matter.
+	for (std::size_t i = 0; i < _tracks.size();) {
+		const Track& track = _tracks[i];
+		const qreal progress =
+		  track.duration > 0 ? qreal(now - track.start) / qreal(track.duration) : 1.0;
+		_apply(track, std::min<qreal>(progress, 1.0));
+		if (progress >= 1.0) {
+			_tracks[i] = _tracks.back();
+			_tracks.pop_back();
+		} else {
+			++i;
+		}
+	}
+	if (_tracks.empty()) {
+		killTimer(_timerId);
+		_timerId = 0;
+		Q_EMIT finished();
+	}
+}
+
+void
+BoardAnimator::_add(Track track) {
+	if (_timerId == 0) {
+		_clock.start();
+		_timerId = startTimer(kFrameInterval, Qt::PreciseTimer);
+	}
+	track.start = _clock.elapsed();
+	_apply(track, 0.0);
+	_tracks.push_back(track);
+}
+
+void
+BoardAnimator::_apply(const Track& track, qreal progress) const {
+	switch (track.kind) {
+		case Kind::Move: {
+			const qreal p = _easing.valueForProgress(progress);
+			track.item->setPos(track.from + (track.to - track.from) * p);
+			break;
+		}
+		case Kind::FadeIn:
+			track.item->setOpacity(progress);
+			break;
+		case Kind::FadeOut:
+			if (progress >= 1.0) {
+				delete track.item;
+			} else {
+				track.item->setOpacity(1.0 - progress);
+			}
+			break;
+	}
+}
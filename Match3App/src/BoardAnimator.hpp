@@ -0,0 +1,78 @@
+//! @file
+#pragma once
+
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QGraphicsItem>
+#include <QObject>
+#include <QPointF>
+#include <vector>
+
+//! @brief Animates all moving, appearing and disappearing board items.
+//! @details A single timer drives every animation, each frame updates all
+//! tracks in one callback, instead of one QPropertyAnimation per item.
+class BoardAnimator : public QObject {
+	Q_OBJECT
+
+	public:
+	BoardAnimator(QObject* parent = 0);
+	virtual ~BoardAnimator();
+	BoardAnimator(const BoardAnimator&) = delete;
+	BoardAnimator& operator=(const BoardAnimator&) = delete;
+
+	//! @brief Gets the duration to move by one cell in milliseconds.
+	int duration() const noexcept;
+	//! @brief Sets the duration to move by one cell in milliseconds.
+	//! @note Longer falls take duration * sqrt(distance), like a free fall.
+	void setDuration(int msec);
+	//! @brief Sets the easing curve applied to moves.
+	void setEasingCurve(const QEasingCurve& easing);
+
+	//! @brief Moves an item.
+	//! @param[in] item The item to move, it must stay alive until the end.
+	//! @param[in] from Start position.
+	//! @param[in] to End position.
+	void move(QGraphicsItem* item, const QPointF& from, const QPointF& to);
+	//! @brief Fades an item in.
+	//! @param[in] item The item to show, it must stay alive until the end.
+	void fadeIn(QGraphicsItem* item);
+	//! @brief Fades an item out then deletes it.
+	//! @param[in] item The item to remove, the animator takes its ownership.
+	void fadeOut(QGraphicsItem* item);
+
+	//! @brief Checks if animations are in progress.
+	bool isRunning() const noexcept;
+	//! @brief Jumps all animations to their end.
+	void finish();
+
+	signals:
+	//! @brief Emitted when the last animation ends.
+	void finished();
+
+	protected:
+	void timerEvent(QTimerEvent* event) override;
+
+	private:
+	enum class Kind { Move, FadeIn, FadeOut };
+	struct Track {
+		QGraphicsItem* item;
+		Kind kind;
+		QPointF from;
+		QPointF to;
+		//! @brief Start time on the timeline in milliseconds.
+		qint64 start;
+		//! @brief Duration in milliseconds.
+		qint64 duration;
+	};
+
+	//! @brief Adds a track and starts the timeline if needed.
+	void _add(Track track);
+	//! @brief Updates a track at progress p in [0, 1].
+	void _apply(const Track& track, qreal progress) const;
+
+	int _duration;
+	QEasingCurve _easing;
+	QElapsedTimer _clock;
+	int _timerId;
+	std::vector<Track> _tracks;
+};
@@ -0,0 +1,170 @@
+//! @file
+
+#include "BoardRenderer.hpp"
+
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+#include <cmath>
+
+BoardRenderer::BoardRenderer(const match3::ConstBoardPtr& board,
+                             const SpriteAtlas& atlas,
+                             QGraphicsItem* parent)
+  : QGraphicsObject(parent)
+  , _board(board)
+  , _atlas(atlas)
+  , _size({0, 0})
+  , _cells()
+  , _fragments()
+  , _preview(false)
+  , _previewFrom(0, 0)
+  , _previewTo(0, 0)
+  , _previewOffset() {
+	// Needed to get the exposed rect in paint().
+	setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+	reset();
+}
+
+QRectF
+BoardRenderer::boundingRect() const {
+	return QRectF(0, 0, _size.x(), _size.y());
+}
+
+void
+BoardRenderer::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*) {
+	const QRectF exposed = option->exposedRect.intersected(boundingRect());
+	if (exposed.isEmpty()) return;
+	const int x0 = std::max(0, int(std::floor(exposed.left())));
+	const int y0 = std::max(0, int(std::floor(exposed.top())));
+	const int x1 = std::min(int(_size.x()), int(std::ceil(exposed.right())));
+	const int y1 = std::min(int(_size.y()), int(std::ceil(exposed.bottom())));
+
+	const QRectF tile = _atlas.tileSource();
+	if (tile.isEmpty()) return;
+	const qreal scaleX = 1.0 / tile.width();
+	const qreal scaleY = 1.0 / tile.height();
+
+	// All tiles first then all items, each layer in a single call.
+	_fragments.clear();
+	for (int y = y0; y < y1; ++y) {
+		for (int x = x0; x < x1; ++x) {
+			_fragments.push_back(QPainter::PixmapFragment::create(
+			  QPointF(x + 0.5, y + 0.5), tile, scaleX, scaleY));
+		}
+	}
+	const std::size_t tiles = _fragments.size();
+	auto previewed          = [this](int x, int y) {
+		return _preview && ((x == _previewFrom.x() && y == _previewFrom.y()) ||
+		                    (x == _previewTo.x() && y == _previewTo.y()));
+	};
+	for (int y = y0; y < y1; ++y) {
+		const match3::TypeId* row = _cells.data() + y * _size.x();
+		for (int x = x0; x < x1; ++x) {
+			if (row[x] == match3::Type::NoneId || previewed(x, y)) continue;
+			_fragments.push_back(QPainter::PixmapFragment::create(
+			  QPointF(x + 0.5, y + 0.5), _atlas.source(row[x]), scaleX, scaleY));
+		}
+	}
+	if (_preview) {
+		// Drawn last, so they slide over their neighbours.
+		for (const auto& [pos, shift] : {std::pair(_previewTo, -_previewOffset),
+		                                 std::pair(_previewFrom, _previewOffset)}) {
+			const match3::TypeId type = typeId(pos);
+			if (type == match3::Type::NoneId) continue;
+			_fragments.push_back(QPainter::PixmapFragment::create(
+			  QPointF(pos.x() + 0.5, pos.y() + 0.5) + shift, _atlas.source(type), scaleX, scaleY));
+		}
+	}
+	painter->drawPixmapFragments(_fragments.data(), int(tiles), _atlas.pixmap());
+	painter->drawPixmapFragments(
+	  _fragments.data() + tiles, int(_fragments.size() - tiles), _atlas.pixmap());
+}
+
+void
+BoardRenderer::reset() {
+	prepareGeometryChange();
+	_size = _board->size();
+	_cells.assign(_size.x() * _size.y(), match3::Type::NoneId);
+	match3::ConstTypesPtr types = _board->types();
+	for (const match3::ConstItemPtr& item : _board->items()) {
+		const match3::Position pos = item->position.get();
+		_cells[pos.y() * _size.x() + pos.x()] =
+		  types ? types->id(item->type.get()) : match3::Type::NoneId;
+	}
+	update();
+}
+
+void
+BoardRenderer::apply(const match3::BoardDelta& delta) {
+	if (delta.operation == match3::BoardDelta::Operation::Resize || delta.size != _size) {
+		reset();
+		return;
+	}
+	// Repainting everything is cheaper than thousands of small rects.
+	const std::size_t touched =
+	  delta.removed.size() + 2 * delta.moved.size() + delta.added.size() + delta.retyped.size();
+	const bool full = touched > _cells.size() / 4;
+	auto set        = [this, full](std::uint32_t cell, match3::TypeId type) {
+		_cells[cell] = type;
+		if (!full) _markDirty(cell);
+	};
+
+	// Same order as documented by BoardDelta: removed, moved, added, retyped.
+	for (const match3::BoardDelta::Entry& removed : delta.removed) {
+		set(removed.cell, match3::Type::NoneId);
+	}
+	// Moves may form cycles (e.g. swap), so empty all sources first.
+	for (const match3::BoardDelta::Move& move : delta.moved) {
+		set(move.from, match3::Type::NoneId);
+	}
+	for (const match3::BoardDelta::Move& move : delta.moved) {
+		set(move.to, move.type);
+	}
+	for (const match3::BoardDelta::Entry& added : delta.added) {
+		set(added.cell, added.type);
+	}
+	for (const match3::BoardDelta::Retype& retyped : delta.retyped) {
+		set(retyped.cell, retyped.to);
+	}
+	if (full) update();
+}
+
+match3::TypeId
+BoardRenderer::typeId(const match3::Position& pos) const {
+	if (pos.x() < 0 || pos.y() < 0 || pos.x() >= int(_size.x()) || pos.y() >= int(_size.y()))
+		return match3::Type::NoneId;
+	return _cells[pos.y() * _size.x() + pos.x()];
+}
+
+void
+BoardRenderer::setSwapPreview(const match3::Position& from,
+                              const match3::Position& to,
+                              const QPointF& offset) {
+	_markPreviewDirty();
+	_preview       = true;
+	_previewFrom   = from;
+	_previewTo     = to;
+	_previewOffset = offset;
+	_markPreviewDirty();
+}
+
+void
+BoardRenderer::clearSwapPreview() {
+	if (!_preview) return;
+	_markPreviewDirty();
+	_preview = false;
+}
+
+void
+BoardRenderer::_markPreviewDirty() {
+	if (!_preview) return;
+	// Both cells, previewed items never leave them.
+	const QRectF from(_previewFrom.x(), _previewFrom.y(), 1, 1);
+	const QRectF to(_previewTo.x(), _previewTo.y(), 1, 1);
+	update(from.united(to));
+}
+
+void
+BoardRenderer::_markDirty(std::uint32_t cell) {
+	// The scene merges the rects, and only the dirty area is exposed to paint().
+	update(QRectF(cell % _size.x(), cell / _size.x(), 1, 1));
+}
@@ -0,0 +1,67 @@
+//! @file
+#pragma once
+
+#include "SpriteAtlas.hpp"
+#include <Match3/Board.hpp>
+#include <Match3/BoardDelta.hpp>
+#include <QGraphicsObject>
+#include <QPainter>
+#include <vector>
+
+//! @brief Draws the whole board as a single scene item.
+//! @details Keeps a copy of the item type of each cell, updated from
+//! @ref match3::BoardDelta, and only paints the cells exposed by the view.
+//! Intended for large boards where one item per Tile and Entity is too slow.
+class BoardRenderer : public QGraphicsObject {
+	public:
+	//! @param[in] board The board displayed.
+	//! @param[in] atlas Sprites, must outlive the renderer.
+	BoardRenderer(const match3::ConstBoardPtr& board,
+	              const SpriteAtlas& atlas,
+	              QGraphicsItem* parent = 0);
+	virtual ~BoardRenderer() = default;
+
+	QRectF boundingRect() const override;
+	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
+
+	//! @brief Reloads all cells from the board.
+	void reset();
+	//! @brief Updates the cells changed by a board operation and schedules
+	//! their repaint.
+	//! @param[in] delta Changes reported by the board.
+	void apply(const match3::BoardDelta& delta);
+
+	//! @brief Gets the type identifier displayed at a cell.
+	//! @param[in] pos Position of the cell.
+	match3::TypeId typeId(const match3::Position& pos) const;
+
+	//! @brief Draws two adjacent items shifted toward each other (i.e. a swap
+	//! in progress), the board is not modified.
+	//! @param[in] from Cell of the item shifted by offset.
+	//! @param[in] to Cell of the item shifted by -offset.
+	//! @param[in] offset Shift in cells.
+	void setSwapPreview(const match3::Position& from,
+	                    const match3::Position& to,
+	                    const QPointF& offset);
+	//! @brief Draws the previewed items back at their cells.
+	void clearSwapPreview();
+
+	protected:
+	//! @brief Schedules the repaint of a cell.
+	void _markDirty(std::uint32_t cell);
+	//! @brief Schedules the repaint of the area covered by the swap preview.
+	void _markPreviewDirty();
+
+	const match3::ConstBoardPtr _board;
+	const SpriteAtlas& _atlas;
+	match3::Size _size;
+	//! @brief Item type of each cell, in row major order.
+	std::vector<match3::TypeId> _cells;
+	//! @brief Fragments drawn by the last paint, kept to avoid allocations.
+	std::vector<QPainter::PixmapFragment> _fragments;
+	//! @brief Whether a swap preview is drawn.
+	bool _preview;
+	match3::Position _previewFrom;
+	match3::Position _previewTo;
+	QPointF _previewOffset;
+};
@@ -3,18 +3,43 @@
 #include "BoardView.hpp"
 
 #include "Entity.hpp"
+#include "SpriteCache.hpp"
 #include "Tile.hpp"
 #include <QDrag>
 #include <QMimeData>
 #include <QMouseEvent>
+#include <cmath>
 
 BoardView::BoardView(const match3::ConstBoardPtr& board, QWidget* parent)
   : QGraphicsView(parent)
   , _board(board)
+  , _boardConnection()
   , _minTileSize(48, 48)
+  , _renderMode(RenderMode::Items)
+  , _atlas()
+  , _spriteNames()
+  , _spriteSize()
+  , _spritesPending(false)
+  , _animator()
+  , _renderer(nullptr)
+  , _gridSize({0, 0})
   , _tiles()
-  , _entities() {
+  , _entities()
+  , _dropPos()
+  , _inputMode(InputMode::Swipe)
+  , _swipeFrom()
+  , _swipeTo()
+  , _swipeOrigin()
+  , _frameTiming(false)
+  , _frameStats()
+  , _frameClock() {
 	_setupWidget();
+	connect(&SpriteCache::instance(), &SpriteCache::ready, this, [this]() {
+		_spritesPending = false;
+		_updateAtlas();
+	});
+	_boardConnection = _board->changed.connect(
+	  [this](const match3::BoardDelta& delta) { onBoardChanged(delta); });
 }
 
 QSize
@@ -28,6 +53,57 @@ BoardView::heightForWidth(int w) const {
 	return w * _board->size().y() / _board->size().x();
 }
 
+BoardView::RenderMode
+BoardView::renderMode() const noexcept {
+	return _renderMode;
+}
+
+void
+BoardView::setRenderMode(RenderMode mode) {
+	if (mode == _renderMode) return;
+	_renderMode = mode;
+	// A single item only needs its dirty cells repainted.
+	setViewportUpdateMode(_renderMode == RenderMode::Single
+	                        ? QGraphicsView::MinimalViewportUpdate
+	                        : QGraphicsView::BoundingRectViewportUpdate);
+	onBoardReset();
+}
+
+BoardView::InputMode
+BoardView::inputMode() const noexcept {
+	return _inputMode;
+}
+
+void
+BoardView::setInputMode(InputMode mode) {
+	_previewSwap(std::nullopt, QPointF());
+	_swipeFrom.reset();
+	_inputMode = mode;
+}
+
+std::optional<match3::Position>
+BoardView::cellAt(const QPoint& pos) const {
+	// Scene units are board cells, so the cell is the integral part.
+	const QPointF scenePos = mapToScene(pos);
+	const int x            = int(std::floor(scenePos.x()));
+	const int y            = int(std::floor(scenePos.y()));
+	if (x < 0 || y < 0 || x >= int(_gridSize.x()) || y >= int(_gridSize.y())) return std::nullopt;
+	return match3::Position(x, y);
+}
+
+void
+BoardView::setFrameTiming(bool enabled) {
+	_frameTiming = enabled;
+	if (!_frameTiming) return;
+	_frameStats.clear();
+	if (!_frameClock.isValid()) _frameClock.start();
+}
+
+const FrameStats&
+BoardView::frameStats() const noexcept {
+	return _frameStats;
+}
+
 void
 BoardView::setDropPos(const QPointF& pos) {
 	_dropPos = pos;
@@ -35,44 +111,141 @@ BoardView::setDropPos(const QPointF& pos) {
 
 void
 BoardView::onBoardReset() {
+	// Entities of the current swipe are about to be destroyed.
+	_swipeFrom.reset();
+	_swipeTo.reset();
+	_animator.finish();
 	scene()->clear();
+	_renderer = nullptr;
+	_gridSize = _board->size();
+	_tiles.assign(_gridSize.x() * _gridSize.y(), nullptr);
+	_entities.assign(_gridSize.x() * _gridSize.y(), nullptr);
+
+	if (_renderMode == RenderMode::Single) {
+		_renderer = new BoardRenderer(_board, _atlas);
+		scene()->addItem(_renderer);
+		scene()->setSceneRect(0, 0, _board->size().x(), _board->size().y());
+		fitInView(sceneRect(), Qt::KeepAspectRatio);
+		_updateAtlas();
+		return;
+	}
 
 	// Create Cell
-	for (int j = 0; j < int(_board->size().y()); ++j) {
-		for (int i = 0; i < int(_board->size().x()); ++i) {
-			match3::ConstCellPtr cell = _board->cell({i, j});
-			if (cell) {
-				Tile* tile = new Tile(cell);
-				scene()->addItem(tile);
-				_tiles.insert(tile);
-			}
-		}
+	for (const match3::ConstCellPtr& cell : _board->cells()) {
+		const match3::Position pos = cell->position.get();
+		Tile* tile                 = new Tile(cell, _atlas);
+		scene()->addItem(tile);
+		_tiles[pos.y() * _gridSize.x() + pos.x()] = tile;
 	}
 
 	// Create Item
-	for (int j = 0; j < int(_board->size().y()); ++j) {
-		for (int i = 0; i < int(_board->size().x()); ++i) {
-			match3::ConstItemPtr item = _board->item({i, j});
-			if (item) {
-				Entity* entity = new Entity(item);
-				scene()->addItem(entity);
-				_entities.insert(entity);
-			}
-		}
+	match3::ConstTypesPtr types = _board->types();
+	for (const match3::ConstItemPtr& item : _board->items()) {
+		const match3::Position pos = item->position.get();
+		Entity* entity =
+		  new Entity(item, types ? types->id(item->type.get()) : match3::Type::NoneId, _atlas);
+		scene()->addItem(entity);
+		_entities[pos.y() * _gridSize.x() + pos.x()] = entity;
 	}
 
 	scene()->setSceneRect(0, 0, _board->size().x(), _board->size().y());
 	fitInView(sceneRect(), Qt::KeepAspectRatio);
+	_updateAtlas();
+}
+
+void
+BoardView::onBoardChanged(const match3::BoardDelta& delta) {
+	if (delta.operation == match3::BoardDelta::Operation::Resize || delta.size != _gridSize) {
+		onBoardReset();
+		return;
+	}
+	if (_renderer) {
+		_swipeFrom.reset();
+		_renderer->clearSwapPreview();
+		if (!delta.added.empty()) _updateAtlas();
+		_renderer->apply(delta);
+		return;
+	}
+
+	// Previous animations are completed, so entities are at their cells.
+	_previewSwap(std::nullopt, QPointF());
+	_swipeFrom.reset();
+	_animator.finish();
+
+	for (const match3::BoardDelta::Entry& removed : delta.removed) {
+		if (Entity* entity = _entities[removed.cell]) _animator.fadeOut(entity);
+		_entities[removed.cell] = nullptr;
+	}
+
+	// Moves may form cycles (e.g. swap), so lift all entities before dropping them.
+	std::vector<Entity*> moving;
+	moving.reserve(delta.moved.size());
+	for (const match3::BoardDelta::Move& move : delta.moved) {
+		moving.push_back(_entities[move.from]);
+		_entities[move.from] = nullptr;
+	}
+	for (std::size_t i = 0; i < delta.moved.size(); ++i) {
+		Entity* entity = moving[i];
+		if (!entity) continue;
+		const match3::Position pos = delta.position(delta.moved[i].to);
+		_animator.move(entity, entity->pos(), QPointF(pos.x(), pos.y()));
+		_entities[delta.moved[i].to] = entity;
+	}
+
+	if (!delta.added.empty()) {
+		// Types may have changed (e.g. on fill).
+		_updateAtlas();
+		// One pass over the board items, instead of one lookup per added item.
+		std::vector<match3::ConstItemPtr> items(_entities.size());
+		for (const match3::ConstItemPtr& item : _board->items()) {
+			items[delta.index(item->position.get())] = item;
+		}
+		for (const match3::BoardDelta::Entry& added : delta.added) {
+			if (!items[added.cell]) continue;
+			delete _entities[added.cell];
+			Entity* entity = new Entity(items[added.cell], added.type, _atlas);
+			scene()->addItem(entity);
+			_animator.fadeIn(entity);
+			_entities[added.cell] = entity;
+		}
+	}
+
+	for (const match3::BoardDelta::Retype& retyped : delta.retyped) {
+		if (Entity* entity = _entities[retyped.cell]) entity->setTypeId(retyped.to);
+	}
 }
 
 void
 BoardView::resizeEvent(QResizeEvent* event) {
 	fitInView(sceneRect(), Qt::KeepAspectRatio);
+	_updateAtlas();
 	QGraphicsView::resizeEvent(event);
 }
 
+void
+BoardView::paintEvent(QPaintEvent* event) {
+	if (!_frameTiming) {
+		QGraphicsView::paintEvent(event);
+		return;
+	}
+	const qint64 begin = _frameClock.nsecsElapsed();
+	QGraphicsView::paintEvent(event);
+	const qint64 end = _frameClock.nsecsElapsed();
+	_frameStats.addFrame(end, end - begin);
+}
+
 void
 BoardView::mousePressEvent(QMouseEvent* event) {
+	if (_inputMode == InputMode::Swipe) {
+		if (event->button() != Qt::LeftButton) return;
+		// Items may still be falling from the previous move.
+		_animator.finish();
+		_swipeFrom   = cellAt(event->pos());
+		_swipeTo     = std::nullopt;
+		_swipeOrigin = mapToScene(event->pos());
+		return;
+	}
+
 	// Find Entity at mouse position
 	if (Entity* dragEntity = dynamic_cast<Entity*>(itemAt(event->pos()))) {
 		dragEntity->dragStart();
@@ -88,7 +261,7 @@ BoardView::mousePressEvent(QMouseEvent* event) {
 			// HotSpot = middle of the tile
 			QTransform tf = transform();
 			drag->setHotSpot(QPoint((tf.m11() + 0.5) / 2, (tf.m22() + 0.5) / 2));
-			drag->setPixmap(dragEntity->pixmap().scaledToWidth(tf.m11()));
+			drag->setPixmap(dragEntity->pixmap());
 			_dropPos = QPointF(-1.0, -1.0);
 			if (drag->exec(Qt::MoveAction) == Qt::MoveAction) {
 				// Verify if item is also present on drop site
@@ -103,6 +276,92 @@ BoardView::mousePressEvent(QMouseEvent* event) {
 	}
 }
 
+void
+BoardView::mouseMoveEvent(QMouseEvent* event) {
+	if (_inputMode != InputMode::Swipe || !_swipeFrom) return;
+	// Follow the dominant axis, by at most one cell.
+	const QPointF delta = mapToScene(event->pos()) - _swipeOrigin;
+	const bool horizontal = std::abs(delta.x()) >= std::abs(delta.y());
+	const qreal distance  = std::min<qreal>(1.0, std::abs(horizontal ? delta.x() : delta.y()));
+	const int sign        = (horizontal ? delta.x() : delta.y()) < 0 ? -1 : 1;
+	const match3::Position to =
+	  *_swipeFrom + (horizontal ? match3::Position(sign, 0) : match3::Position(0, sign));
+	if (to.x() < 0 || to.y() < 0 || to.x() >= int(_gridSize.x()) || to.y() >= int(_gridSize.y())) {
+		_previewSwap(std::nullopt, QPointF());
+		return;
+	}
+	const QPointF offset = horizontal ? QPointF(sign * distance, 0.) : QPointF(0., sign * distance);
+	_previewSwap(to, offset);
+}
+
+void
+BoardView::mouseReleaseEvent(QMouseEvent* event) {
+	if (_inputMode != InputMode::Swipe || !_swipeFrom) return;
+	const match3::Position from = *_swipeFrom;
+	const std::optional<match3::Position> to = _swipeTo;
+	const QPointF delta                      = mapToScene(event->pos()) - _swipeOrigin;
+	_previewSwap(std::nullopt, QPointF());
+	_swipeFrom.reset();
+	// Past half a cell the swap is committed, the board delta moves the items.
+	if (to && std::max(std::abs(delta.x()), std::abs(delta.y())) >= 0.5) {
+		Q_EMIT swapRequested(from, *to);
+	}
+}
+
+void
+BoardView::_previewSwap(const std::optional<match3::Position>& to, const QPointF& offset) {
+	if (_renderer) {
+		if (to && _swipeFrom)
+			_renderer->setSwapPreview(*_swipeFrom, *to, offset);
+		else
+			_renderer->clearSwapPreview();
+		_swipeTo = to;
+		return;
+	}
+	auto entityAt = [this](const match3::Position& pos) -> Entity* {
+		return _entities[pos.y() * _gridSize.x() + pos.x()];
+	};
+	auto place = [](Entity* entity, const match3::Position& pos, const QPointF& shift) {
+		if (entity) entity->setPos(QPointF(pos.x(), pos.y()) + shift);
+	};
+	// Put back the previous neighbour when the direction changes.
+	if (_swipeTo && _swipeTo != to) place(entityAt(*_swipeTo), *_swipeTo, QPointF());
+	_swipeTo = to;
+	if (!_swipeFrom) return;
+	place(entityAt(*_swipeFrom), *_swipeFrom, to ? offset : QPointF());
+	if (to) place(entityAt(*to), *to, -offset);
+}
+
+void
+BoardView::_updateAtlas() {
+	match3::ConstTypesPtr types = _board->types();
+	if (!types) return;
+	// A tile is 1x1 in scene coordinates, thus its size in pixels is the scale.
+	const QTransform tf = transform();
+	const QSize tileSize(qRound(tf.m11()), qRound(tf.m22()));
+	const QSize spriteSize = SpriteAtlas::spriteSize(tileSize, devicePixelRatioF());
+	if (spriteSize.isEmpty()) return;
+	// Rasterizing takes time, meanwhile the current sprites are drawn scaled.
+	// New types have no sprite to show yet, so they are rasterized right away.
+	const QStringList names = SpriteAtlas::spriteNames(*types);
+	SpriteCache& cache      = SpriteCache::instance();
+	if (_atlas.contains(*types) && !cache.contains(names, spriteSize)) {
+		if (names != _spriteNames || spriteSize != _spriteSize) {
+			_spriteNames    = names;
+			_spriteSize     = spriteSize;
+			_spritesPending = true;
+			cache.request(names, spriteSize);
+			return;
+		}
+		// Once the request is done, sprites still missing (e.g. evicted
+		// meanwhile) are rasterized by the update instead of requested again.
+		if (_spritesPending) return;
+	}
+	if (_atlas.update(*types, tileSize, devicePixelRatioF())) {
+		viewport()->update();
+	}
+}
+
 void
 BoardView::_setupWidget() {
 	setObjectName("Board");
@@ -1,19 +1,65 @@
 //! @file
 #pragma once
 
+#include "BoardAnimator.hpp"
+#include "BoardRenderer.hpp"
 #include "Entity.hpp"
+#include "FrameStats.hpp"
+#include "SpriteAtlas.hpp"
 #include "Tile.hpp"
 #include <Match3/Board.hpp>
+#include <Match3/BoardDelta.hpp>
+#include <QElapsedTimer>
 #include <QGraphicsView>
-#include <QSet>
+#include <QSize>
+#include <QStringList>
+#include <Signal/Connection.hpp>
+#include <optional>
+#include <vector>
 
 class BoardView : public QGraphicsView {
 	Q_OBJECT
 
 	public:
+	//! @brief How the board is drawn.
+	enum class RenderMode {
+		//! @brief One scene item per Tile and per Entity (supports drag and drop).
+		Items,
+		//! @brief A single @ref BoardRenderer item, for large boards.
+		Single
+	};
+	//! @brief How the player moves items.
+	enum class InputMode {
+		//! @brief A QDrag is started on the pressed Entity and dropped on a Tile
+		//! (RenderMode::Items only, the board is not modified).
+		DragDrop,
+		//! @brief Press and slide toward a neighbour cell, the swap is previewed
+		//! in place and @ref swapRequested is emitted on release.
+		Swipe
+	};
+
 	BoardView(const match3::ConstBoardPtr& board, QWidget* parent = 0);
 	virtual ~BoardView() = default;
 
+	RenderMode renderMode() const noexcept;
+	//! @brief Changes the render mode, the scene is rebuilt.
+	void setRenderMode(RenderMode mode);
+
+	InputMode inputMode() const noexcept;
+	void setInputMode(InputMode mode);
+
+	//! @brief Gets the board cell under a viewport position.
+	//! @details Only uses the view transform, no scene item lookup.
+	//! @param[in] pos Position in viewport coordinates.
+	//! @return The cell position, std::nullopt if outside the board.
+	std::optional<match3::Position> cellAt(const QPoint& pos) const;
+
+	//! @brief Enables the timing of each painted frame (disabled by default).
+	//! @note Statistics are cleared when enabled.
+	void setFrameTiming(bool enabled);
+	//! @brief Gets the statistics of the last painted frames.
+	const FrameStats& frameStats() const noexcept;
+
 	QSize sizeHint() const override;
 	int heightForWidth(int w) const override;
 
@@ -25,21 +71,68 @@ class BoardView : public QGraphicsView {
 	QSize tileSize() const;
 	void setTileSize(QSize tile);
 
+	signals:
+	//! @brief Emitted when the player swipes an item toward a neighbour cell.
+	//! @param[in] from Position of the swiped item.
+	//! @param[in] to Position of the neighbour cell.
+	void swapRequested(const match3::Position& from, const match3::Position& to);
+
 	public slots:
 	//! @brief Clear all, and recreate them if any.
 	void onBoardReset();
+	//! @brief Updates only the entities touched by a board operation.
+	//! @param[in] delta Changes reported by the board.
+	void onBoardChanged(const match3::BoardDelta& delta);
 
 	protected:
 	virtual void resizeEvent(QResizeEvent* event) override;
-	//! @brief When clic on item, perform Drag&Drop.
+	virtual void paintEvent(QPaintEvent* event) override;
+	//! @brief When clic on item, perform Drag&Drop or start a swipe.
 	virtual void mousePressEvent(QMouseEvent* event) override;
+	virtual void mouseMoveEvent(QMouseEvent* event) override;
+	virtual void mouseReleaseEvent(QMouseEvent* event) override;
 
 	void _setupWidget();
+	//! @brief Rebuilds the sprite atlas if tile size or types changed.
+	void _updateAtlas();
+	//! @brief Shows the swiped item and its neighbour shifted by offset.
+	//! @param[in] to Neighbour cell, std::nullopt to only restore the items.
+	//! @param[in] offset Shift of the swiped item in cells (in [-1, 1]).
+	void _previewSwap(const std::optional<match3::Position>& to, const QPointF& offset);
 
 	match3::ConstBoardPtr _board;
+	Signal::Connection _boardConnection;
 	QSize _minTileSize;
-	QSet<Tile*> _tiles;
-	QSet<Entity*> _entities;
+	RenderMode _renderMode;
+	SpriteAtlas _atlas;
+	//! @brief Sprite names of the last SpriteCache request.
+	QStringList _spriteNames;
+	//! @brief Sprite size of the last SpriteCache request.
+	QSize _spriteSize;
+	//! @brief The last SpriteCache request is not done yet.
+	bool _spritesPending;
+	//! @brief Animates entities in RenderMode::Items.
+	BoardAnimator _animator;
+	//! @brief The board item in RenderMode::Single, nullptr otherwise.
+	BoardRenderer* _renderer;
+	//! @brief Size of the grids below.
+	match3::Size _gridSize;
+	//! @brief Tiles indexed by row major cell index.
+	std::vector<Tile*> _tiles;
+	//! @brief Entities indexed by row major cell index, nullptr if cell is empty.
+	std::vector<Entity*> _entities;
 
 	QPointF _dropPos;
+	InputMode _inputMode;
+	//! @brief Cell pressed by the current swipe, std::nullopt if none.
+	std::optional<match3::Position> _swipeFrom;
+	//! @brief Neighbour cell currently previewed, std::nullopt if none.
+	std::optional<match3::Position> _swipeTo;
+	//! @brief Press position of the current swipe, in scene coordinates.
+	QPointF _swipeOrigin;
+	//! @brief Frames are timed by paintEvent().
+	bool _frameTiming;
+	FrameStats _frameStats;
+	//! @brief Monotonic clock used to timestamp frames.
+	QElapsedTimer _frameClock;
 };
@@ -3,11 +3,15 @@
 #include "Entity.hpp"
 #include <QCursor>
 #include <QPainter>
-#include <QPixmapCache>
 
-Entity::Entity(const match3::ConstItemPtr& entity, QGraphicsItem* parent)
+Entity::Entity(const match3::ConstItemPtr& entity,
+               match3::TypeId type,
+               const SpriteAtlas& atlas,
+               QGraphicsItem* parent)
   : QGraphicsObject(parent)
   , _entity(entity)
+  , _type(type)
+  , _atlas(atlas)
   , _dragStart(false) {
 	setPos(_entity->position.get().x(), _entity->position.get().y());
 	setTransformOriginPoint(0.5, 0.5);
@@ -23,24 +27,26 @@ Entity::boundingRect() const {
 
 void
 Entity::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
-	painter->setRenderHint(QPainter::Antialiasing);
-	painter->setRenderHint(QPainter::SmoothPixmapTransform);
-
 	if (_dragStart) painter->setOpacity(0.5);
 
-	painter->drawPixmap(QRect(0, 0, 1, 1), pixmap());
+	// Atlas is rasterized at the tile size, so no smooth scaling is needed.
+	painter->drawPixmap(boundingRect(), _atlas.pixmap(), _atlas.source(_type));
 }
 
 QPixmap
-Entity::pixmap() {
-	std::string name = _entity->type.get().name();
-
-	QPixmap pm;
-	if (!QPixmapCache::find(QString::fromStdString(name), &pm)) {
-		pm.load(":/img/" + QString::fromStdString(name) + ".png");
-		QPixmapCache::insert(QString::fromStdString(name), pm);
-	}
-	return pm;
+Entity::pixmap() const {
+	return _atlas.sprite(_type);
+}
+
+match3::TypeId
+Entity::typeId() const noexcept {
+	return _type;
+}
+
+void
+Entity::setTypeId(match3::TypeId type) {
+	_type = type;
+	update();
 }
 
 void
@@ -1,23 +1,36 @@
 //! @file
 #pragma once
 
+#include "SpriteAtlas.hpp"
 #include <Match3/Item.hpp>
 #include <QGraphicsObject>
 
 class Entity : public QGraphicsObject {
 	public:
-	Entity(const match3::ConstItemPtr& entity, QGraphicsItem* parent = 0);
+	//! @param[in] entity The item displayed.
+	//! @param[in] type Type identifier of the item, used to find its sprite.
+	//! @param[in] atlas Sprites, must outlive the entity.
+	Entity(const match3::ConstItemPtr& entity,
+	       match3::TypeId type,
+	       const SpriteAtlas& atlas,
+	       QGraphicsItem* parent = 0);
 	virtual ~Entity() = default;
 
 	QRectF boundingRect() const override;
 	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
 
-	QPixmap pixmap();
+	QPixmap pixmap() const;
+
+	match3::TypeId typeId() const noexcept;
+	//! @brief Updates the type identifier when the item is retyped.
+	void setTypeId(match3::TypeId type);
 
 	void dragStart();
 	void dragStop();
 
 	protected:
 	const match3::ConstItemPtr _entity;
+	match3::TypeId _type;
+	const SpriteAtlas& _atlas;
 	bool _dragStart;
 };
@@ -0,0 +1,56 @@
+//! @file
+
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+FrameStats::FrameStats(std::size_t capacity)
+  : _frames(std::max<std::size_t>(capacity, 2))
+  , _next(0)
+  , _size(0)
+  , _sorted() {
+	_sorted.reserve(_frames.size());
+}
+
+void
+FrameStats::addFrame(qint64 timestamp, qint64 duration) {
+	_frames[_next] = {timestamp, duration};
+	_next          = (_next + 1) % _frames.size();
+	_size          = std::min(_size + 1, _frames.size());
+}
+
+void
+FrameStats::clear() noexcept {
+	_next = 0;
+	_size = 0;
+}
+
+std::size_t
+FrameStats::size() const noexcept {
+	return _size;
+}
+
+double
+FrameStats::fps() const noexcept {
+	if (_size < 2) return 0.;
+	const std::size_t last  = (_next + _frames.size() - 1) % _frames.size();
+	const std::size_t first = (_next + _frames.size() - _size) % _frames.size();
+	const qint64 span       = _frames[last].timestamp - _frames[first].timestamp;
+	if (span <= 0) return 0.;
+	return double(_size - 1) * 1e9 / double(span);
+}
+
+qint64
+FrameStats::percentile(double p) const {
+	if (_size == 0) return 0;
+	_sorted.clear();
+	for (std::size_t i = 0; i < _size; ++i) {
+		_sorted.push_back(_frames[i].duration);
+	}
+	// nearest-rank percentile
+	const std::size_t rank =
+	  std::clamp<std::size_t>(std::size_t(std::ceil(p * double(_size))), 1, _size) - 1;
+	std::nth_element(_sorted.begin(), _sorted.begin() + rank, _sorted.end());
+	return _sorted[rank];
+}
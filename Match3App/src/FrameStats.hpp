@@ -0,0 +1,44 @@
+//! @file
+#pragma once
+
+#include <QtGlobal>
+#include <cstddef>
+#include <vector>
+
+//! @brief Rolling statistics over the last painted frames.
+//! @details Samples are stored in a fixed size ring buffer, recording a frame
+//! never allocates.
+class FrameStats {
+	public:
+	//! @param[in] capacity Number of frames kept (i.e. the rolling window).
+	explicit FrameStats(std::size_t capacity = 120);
+
+	//! @brief Records a frame.
+	//! @param[in] timestamp End of the frame in nanoseconds (monotonic clock).
+	//! @param[in] duration Time spent painting the frame in nanoseconds.
+	void addFrame(qint64 timestamp, qint64 duration);
+	//! @brief Removes all frames.
+	void clear() noexcept;
+
+	//! @brief Gets the number of frames in the window.
+	std::size_t size() const noexcept;
+	//! @brief Gets the number of frames per second over the window.
+	//! @return 0 if there are less than two frames.
+	double fps() const noexcept;
+	//! @brief Gets a frame duration percentile over the window.
+	//! @param[in] p Percentile in [0, 1] (e.g. 0.99).
+	//! @return The duration in nanoseconds (nearest rank), 0 if empty.
+	qint64 percentile(double p) const;
+
+	private:
+	struct Frame {
+		qint64 timestamp;
+		qint64 duration;
+	};
+	std::vector<Frame> _frames;
+	//! @brief Next slot written.
+	std::size_t _next;
+	std::size_t _size;
+	//! @brief Scratch buffer used to compute percentiles.
+	mutable std::vector<qint64> _sorted;
+};
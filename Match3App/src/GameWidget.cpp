@@ -2,8 +2,8 @@
 
 #include "GameWidget.hpp"
 
-#include "StatWidget.hpp"
 #include <QInputDialog>
+#include <QShortcut>
 #include <QVBoxLayout>
 
 GameWidget::GameWidget(QWidget* parent)
@@ -11,8 +11,12 @@ GameWidget::GameWidget(QWidget* parent)
   , _game()
   , _resetButton()
   , _enemyWidget()
-  , _boardView() {
-	_game.setTypes({{"pkm_1"}});
+  , _boardView()
+  , _scoreStat()
+  , _countStat()
+  , _overlay()
+  , _statBridge() {
+	_game.setTypes({{"pkm_1"}, {"pkm_2"}});
 	_game.resize({1, 1});
 	_game.fillBoard();
 
@@ -59,13 +63,12 @@ GameWidget::slotResetBoard(void) {
 		}
 		{
 			QComboBox* comboBox = new QComboBox(&dialog);
-			comboBox->addItem("1", 1);
 			comboBox->addItem("2", 2);
 			comboBox->addItem("3", 3);
 			comboBox->addItem("4", 4);
 			comboBox->addItem("5", 5);
 			comboBox->addItem("6", 6);
-			comboBox->setCurrentIndex(0);
+			comboBox->setCurrentIndex(1);
 			form->addRow("Color Number", comboBox);
 			confs.insert("Colors", comboBox);
 		}
@@ -96,7 +99,7 @@ GameWidget::slotResetBoard(void) {
 		_game.resize(size);
 		_game.setTypes(types);
 		_game.fillBoard();
-		emit boardUpdated();
+		Q_EMIT boardUpdated();
 	}
 }
 
@@ -114,10 +117,13 @@ GameWidget::_setupWidget() {
 
 			StatWidget* lvl = new StatWidget("Level", this);
 			statusLayout->addWidget(lvl);
-			StatWidget* score = new StatWidget("Score", this);
-			statusLayout->addWidget(score);
-			StatWidget* count = new StatWidget("Count", this);
-			statusLayout->addWidget(count);
+			_scoreStat = new StatWidget("Score", this);
+			statusLayout->addWidget(_scoreStat);
+			_countStat = new StatWidget("Count", this);
+			statusLayout->addWidget(_countStat);
+			// Updated at most once per frame, however often the game changes them.
+			_statBridge.bind(_game.scoreChanged, _game.score(), _scoreStat);
+			_statBridge.bind(_game.movesChanged, _game.moves(), _countStat);
 			QSpacerItem* spacer =
 			  new QSpacerItem(0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding);
 			statusLayout->addItem(spacer);
@@ -145,7 +151,18 @@ GameWidget::_setupWidget() {
 
 	{ // Bottom Screen
 		_boardView = new BoardView(_game.board(), this);
+		// e.g. MATCH3_RENDERER=single for large boards.
+		if (qgetenv("MATCH3_RENDERER") == "single") {
+			_boardView->setRenderMode(BoardView::RenderMode::Single);
+		}
+		// e.g. MATCH3_INPUT=dragdrop for the previous QDrag based input.
+		if (qgetenv("MATCH3_INPUT") == "dragdrop") {
+			_boardView->setInputMode(BoardView::InputMode::DragDrop);
+		}
 		layout()->addWidget(_boardView);
+
+		_overlay = new StatsOverlay(_game, _boardView);
+		if (qgetenv("MATCH3_OVERLAY") == "1") _overlay->show();
 	}
 
 	{ // StatusBar
@@ -164,8 +181,18 @@ GameWidget::_setupWidget() {
 		layout()->addItem(statusLayout);
 	}
 
+	// BoardView follows the board changes by itself.
 	QWidget::connect(
 	  _resetButton, &QPushButton::clicked, this, &GameWidget::slotResetBoard);
-	QWidget::connect(
-	  this, &GameWidget::boardUpdated, _boardView, &BoardView::onBoardReset);
+	QWidget::connect(_boardView,
+	                 &BoardView::swapRequested,
+	                 this,
+	                 [this](const match3::Position& from, const match3::Position& to) {
+		                 _game.play({from, to});
+	                 });
+	QShortcut* overlayShortcut = new QShortcut(QKeySequence(Qt::Key_F3), this);
+	QWidget::connect(overlayShortcut, &QShortcut::activated, this, [this]() {
+		_overlay->setVisible(!_overlay->isVisible());
+	});
 }
+
@@ -5,6 +5,9 @@
 
 #include "BoardView.hpp"
 #include "EnemyWidget.hpp"
+#include "StatBridge.hpp"
+#include "StatWidget.hpp"
+#include "StatsOverlay.hpp"
 #include <Match3/Game.hpp>
 #include <QPushButton>
 
@@ -29,6 +32,12 @@ class GameWidget : public QWidget {
 
 	EnemyWidget* _enemyWidget;
 	BoardView* _boardView;
+	StatWidget* _scoreStat;
+	StatWidget* _countStat;
+	//! @brief Diagnostic overlay, toggled with F3 (or MATCH3_OVERLAY=1).
+	StatsOverlay* _overlay;
+	//! @brief Feeds the game score and moves to the StatWidgets.
+	StatBridge _statBridge;
 
 	void _setupWidget();
 };
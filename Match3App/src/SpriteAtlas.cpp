@@ -0,0 +1,102 @@
+//! @file
+
+#include "SpriteAtlas.hpp"
+
+#include "SpriteCache.hpp"
+#include <QPainter>
+#include <QString>
+#include <cmath>
+
+SpriteAtlas::SpriteAtlas()
+  : _pixmap()
+  , _spriteSize()
+  , _devicePixelRatio(1.0)
+  , _names() {}
+
+QSize
+SpriteAtlas::spriteSize(QSize tileSize, qreal devicePixelRatio) {
+	return QSize(std::lround(tileSize.width() * devicePixelRatio),
+	             std::lround(tileSize.height() * devicePixelRatio));
+}
+
+QStringList
+SpriteAtlas::spriteNames(const match3::Types& types) {
+	QStringList res;
+	for (const match3::Type& type : types.palette()) {
+		res.push_back(QString::fromStdString(type.name()));
+	}
+	res.push_back("tile");
+	return res;
+}
+
+bool
+SpriteAtlas::contains(const match3::Types& types) const {
+	const std::vector<match3::Type>& palette = types.palette();
+	if (_names.size() != match3::Type::FirstId + palette.size()) return false;
+	for (std::size_t i = 0; i < palette.size(); ++i) {
+		if (_names[match3::Type::FirstId + i] != palette[i].name()) return false;
+	}
+	return true;
+}
+
+bool
+SpriteAtlas::update(const match3::Types& types, QSize tileSize, qreal devicePixelRatio) {
+	const QSize spriteSize = SpriteAtlas::spriteSize(tileSize, devicePixelRatio);
+	if (spriteSize.isEmpty()) return false;
+
+	// Slots match identifiers, thus None and Any slots stay empty.
+	std::vector<std::string> names(match3::Type::FirstId);
+	for (const match3::Type& type : types.palette()) {
+		names.push_back(type.name());
+	}
+	if (spriteSize == _spriteSize && devicePixelRatio == _devicePixelRatio && names == _names)
+		return false;
+
+	_spriteSize       = spriteSize;
+	_devicePixelRatio = devicePixelRatio;
+	_names            = std::move(names);
+
+	// Last slot is the tile background.
+	_pixmap = QPixmap(_spriteSize.width() * int(_names.size() + 1), _spriteSize.height());
+	_pixmap.fill(Qt::transparent);
+	QPainter painter(&_pixmap);
+	// Sprites are already rasterized at the right size (usually by a worker thread).
+	SpriteCache& cache = SpriteCache::instance();
+	auto draw          = [&](std::size_t slot, const QString& name) {
+		const QImage image = cache.image(name, _spriteSize);
+		if (image.isNull()) return;
+		painter.drawImage(QPoint(int(slot) * _spriteSize.width(), 0), image);
+	};
+	for (std::size_t i = match3::Type::FirstId; i < _names.size(); ++i) {
+		draw(i, QString::fromStdString(_names[i]));
+	}
+	draw(_names.size(), "tile");
+	painter.end();
+	return true;
+}
+
+const QPixmap&
+SpriteAtlas::pixmap() const noexcept {
+	return _pixmap;
+}
+
+QRectF
+SpriteAtlas::source(match3::TypeId id) const noexcept {
+	// Never return a null rect, drawPixmap would draw the whole atlas.
+	const int slot = id < _names.size() ? id : match3::Type::NoneId;
+	return QRectF(slot * _spriteSize.width(), 0, _spriteSize.width(), _spriteSize.height());
+}
+
+QRectF
+SpriteAtlas::tileSource() const noexcept {
+	if (_names.empty()) return QRectF();
+	return QRectF(
+	  int(_names.size()) * _spriteSize.width(), 0, _spriteSize.width(), _spriteSize.height());
+}
+
+QPixmap
+SpriteAtlas::sprite(match3::TypeId id) const {
+	QPixmap res = _pixmap.copy(source(id).toAlignedRect());
+	res.setDevicePixelRatio(_devicePixelRatio);
+	return res;
+}
@@ -0,0 +1,59 @@
+//! @file
+#pragma once
+
+#include <Match3/Types.hpp>
+#include <QPixmap>
+#include <QRectF>
+#include <QSize>
+#include <QStringList>
+#include <string>
+#include <vector>
+
+//! @brief Sprites of all item types rasterized in a single pixmap.
+//! @details Sprites are laid out in a row, indexed by @ref match3::TypeId and
+//! followed by the tile background, at the tile size in device pixels, so
+//! painting is a single 1:1 drawPixmap from a sub-rect.
+//! Sprites are rasterized by @ref SpriteCache.
+class SpriteAtlas {
+	public:
+	SpriteAtlas();
+
+	//! @brief Gets the size of a sprite in device pixels.
+	//! @param[in] tileSize Size of a tile in logical pixels.
+	//! @param[in] devicePixelRatio Device pixel ratio of the target.
+	static QSize spriteSize(QSize tileSize, qreal devicePixelRatio);
+	//! @brief Gets the names of the sprites needed by an atlas.
+	//! @param[in] types Types to rasterize.
+	//! @return The sprite name of each type followed by the tile background.
+	static QStringList spriteNames(const match3::Types& types);
+	//! @brief Checks if the atlas contains the sprites of these types (at any size).
+	bool contains(const match3::Types& types) const;
+
+	//! @brief Rasterizes the sprites if tile size, pixel ratio or types changed.
+	//! @param[in] types Types to rasterize.
+	//! @param[in] tileSize Size of a tile in logical pixels.
+	//! @param[in] devicePixelRatio Device pixel ratio of the target.
+	//! @return true if the atlas has been rebuilt.
+	bool update(const match3::Types& types, QSize tileSize, qreal devicePixelRatio);
+
+	//! @brief Gets the pixmap containing all sprites.
+	const QPixmap& pixmap() const noexcept;
+	//! @brief Gets the area of a sprite in @ref pixmap.
+	//! @param[in] id The type identifier.
+	//! @return Sprite area, an empty sprite area if id is unknown.
+	QRectF source(match3::TypeId id) const noexcept;
+	//! @brief Gets the area of the tile background in @ref pixmap.
+	//! @return Tile area, empty if the atlas is not built yet.
+	QRectF tileSource() const noexcept;
+	//! @brief Gets a copy of a single sprite (e.g. for drag and drop).
+	//! @param[in] id The type identifier.
+	QPixmap sprite(match3::TypeId id) const;
+
+	private:
+	QPixmap _pixmap;
+	//! @brief Size of a sprite in device pixels.
+	QSize _spriteSize;
+	qreal _devicePixelRatio;
+	//! @brief Type names rasterized, indexed by identifier.
+	std::vector<std::string> _names;
+};
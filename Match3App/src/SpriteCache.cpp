@@ -0,0 +1,200 @@
+//! @file
+
+#include "SpriteCache.hpp"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QSaveFile>
+#include <QStandardPaths>
+#ifdef MATCH3_HAS_SVG
+#include <QSvgRenderer>
+#endif
+
+namespace {
+//! @brief Version of the on-disk cache layout and rendering.
+//! @note Bump it when the rasterization changes, previous caches are removed.
+constexpr int kCacheVersion = 1;
+
+//! @brief Maximum memory used by rasterized sprites in KiB.
+constexpr int kMemoryLimit = 64 * 1024;
+
+QString
+key(const QString& name, QSize size) {
+	return QString("%1@%2x%3").arg(name).arg(size.width()).arg(size.height());
+}
+} // namespace
+
+SpriteCache&
+SpriteCache::instance() {
+	static SpriteCache cache;
+	return cache;
+}
+
+SpriteCache::SpriteCache()
+  : QObject()
+  , _mutex()
+  , _sources()
+  , _images(kMemoryLimit)
+  , _directory()
+  , _pool()
+  , _generation(0) {
+	const QString base = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	if (!base.isEmpty()) {
+		_directory = base + QString("/sprites/v%1").arg(kCacheVersion);
+	}
+	// One worker, requests are served in order.
+	_pool.setMaxThreadCount(1);
+}
+
+SpriteCache::~SpriteCache() {
+	_pool.clear();
+	_pool.waitForDone();
+}
+
+void
+SpriteCache::preload() {
+	_pool.start([this]() {
+		QStringList names = QDir(":/img").entryList({"*.png"}, QDir::Files);
+		for (QString& name : names) {
+			_source(name.chopped(4));
+		}
+		_removeStaleDirectories();
+	});
+}
+
+void
+SpriteCache::request(const QStringList& names, QSize size) {
+	const int generation = ++_generation;
+	_pool.start([this, names, size, generation]() {
+		if (generation != _generation) return; // superseded
+		for (const QString& name : names) {
+			image(name, size);
+		}
+		QMetaObject::invokeMethod(this, [this]() { Q_EMIT ready(); }, Qt::QueuedConnection);
+	});
+}
+
+void
+SpriteCache::wait() {
+	_pool.waitForDone();
+}
+
+bool
+SpriteCache::contains(const QStringList& names, QSize size) const {
+	QMutexLocker lock(&_mutex);
+	for (const QString& name : names) {
+		// Missing sources are recorded as nullptr by _source().
+		const auto source = _sources.constFind(name);
+		if (source != _sources.constEnd() && !source.value()) continue;
+		if (!_images.contains(key(name, size))) return false;
+	}
+	return true;
+}
+
+QImage
+SpriteCache::image(const QString& name, QSize size) {
+	const QString id = key(name, size);
+	{
+		QMutexLocker lock(&_mutex);
+		if (const QImage* res = _images.object(id)) return *res;
+	}
+	const std::shared_ptr<const Source> source = _source(name);
+	if (!source || size.isEmpty()) return QImage();
+
+	QString path;
+	{
+		QMutexLocker lock(&_mutex);
+		if (!_directory.isEmpty()) {
+			path = QString("%1/%2-%3.png").arg(_directory, id, source->digest);
+		}
+	}
+	QImage res;
+	if (!path.isEmpty()) res.load(path, "PNG");
+	if (res.size() != size) {
+		res = _rasterize(*source, size);
+		if (!path.isEmpty() && QDir().mkpath(QFileInfo(path).path())) {
+			// Written atomically, so a concurrent launch never reads a partial file.
+			QSaveFile file(path);
+			if (file.open(QIODevice::WriteOnly) && res.save(&file, "PNG")) file.commit();
+		}
+	}
+	res = res.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+	QMutexLocker lock(&_mutex);
+	_images.insert(id, new QImage(res), qMax<qsizetype>(1, res.sizeInBytes() / 1024));
+	return res;
+}
+
+QString
+SpriteCache::directory() const {
+	QMutexLocker lock(&_mutex);
+	return _directory;
+}
+
+void
+SpriteCache::setDirectory(const QString& dir) {
+	QMutexLocker lock(&_mutex);
+	_directory = dir;
+}
+
+std::shared_ptr<const SpriteCache::Source>
+SpriteCache::_source(const QString& name) {
+	QMutexLocker lock(&_mutex);
+	QHash<QString, std::shared_ptr<const Source>>::const_iterator it = _sources.constFind(name);
+	if (it != _sources.constEnd()) return it.value();
+
+	// Decoding under the lock, so concurrent callers don't decode twice.
+	std::shared_ptr<Source> source = std::make_shared<Source>();
+	QByteArray data;
+#ifdef MATCH3_HAS_SVG
+	QFile svg(":/svg/" + name + ".svg");
+	if (svg.open(QIODevice::ReadOnly)) source->svg = data = svg.readAll();
+#endif
+	if (source->svg.isEmpty()) {
+		QFile png(":/img/" + name + ".png");
+		if (png.open(QIODevice::ReadOnly)) data = png.readAll();
+		source->image.loadFromData(data, "PNG");
+		if (source->image.isNull()) source.reset();
+	}
+	if (source) {
+		source->digest = QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex().left(8);
+	}
+	_sources.insert(name, source);
+	return source;
+}
+
+QImage
+SpriteCache::_rasterize(const Source& source, QSize size) {
+	QImage res(size, QImage::Format_ARGB32_Premultiplied);
+	res.fill(Qt::transparent);
+	QPainter painter(&res);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+#ifdef MATCH3_HAS_SVG
+	if (!source.svg.isEmpty()) {
+		QSvgRenderer renderer(source.svg);
+		renderer.setAspectRatioMode(Qt::KeepAspectRatio);
+		renderer.render(&painter, QRectF(QPointF(0, 0), QSizeF(size)));
+		return res;
+	}
+#endif
+	const QImage scaled =
+	  source.image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	painter.drawImage(
+	  QPoint((size.width() - scaled.width()) / 2, (size.height() - scaled.height()) / 2), scaled);
+	return res;
+}
+
+void
+SpriteCache::_removeStaleDirectories() {
+	const QString current = directory();
+	if (current.isEmpty()) return;
+	QDir root(QFileInfo(current).path());
+	const QString name = QFileInfo(current).fileName();
+	for (const QString& dir : root.entryList({"v*"}, QDir::Dirs | QDir::NoDotAndDotDot)) {
+		if (dir != name) QDir(root.filePath(dir)).removeRecursively();
+	}
+}
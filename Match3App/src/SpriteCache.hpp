@@ -0,0 +1,92 @@
+//! @file
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+//! @brief Rasterizes sprites at a given size in device pixels, off the GUI thread.
+//! @details Sprites are rendered from `:/svg/<name>.svg` when Qt Svg is
+//! available, otherwise scaled from `:/img/<name>.png`. Rasterized images are
+//! kept in memory and in a versioned on-disk cache, so later launches skip the
+//! (slow) SVG rendering. All methods are thread safe.
+class SpriteCache : public QObject {
+	Q_OBJECT
+
+	public:
+	//! @brief Gets the application wide cache.
+	static SpriteCache& instance();
+
+	//! @brief Loads all sprite sources on a worker thread (e.g. at startup).
+	void preload();
+	//! @brief Rasterizes sprites on a worker thread, @ref ready is emitted when done.
+	//! @details A new request supersedes the pending ones (e.g. while resizing).
+	//! @param[in] names Sprite names.
+	//! @param[in] size Size in device pixels.
+	void request(const QStringList& names, QSize size);
+	//! @brief Waits until all requests are done.
+	void wait();
+
+	//! @brief Checks if sprites are already rasterized in memory.
+	//! @details Names known to have no source count as rasterized, so a
+	//! missing sprite is not requested over and over.
+	//! @param[in] names Sprite names.
+	//! @param[in] size Size in device pixels.
+	bool contains(const QStringList& names, QSize size) const;
+	//! @brief Gets a sprite, rasterizing it in the calling thread if needed.
+	//! @param[in] name Sprite name.
+	//! @param[in] size Size in device pixels.
+	//! @return The sprite, a null image if there is no source for this name.
+	QImage image(const QString& name, QSize size);
+
+	//! @brief Gets the on-disk cache directory, empty if disabled.
+	QString directory() const;
+	//! @brief Changes the on-disk cache directory.
+	//! @param[in] dir The directory, empty to disable the on-disk cache.
+	void setDirectory(const QString& dir);
+
+	signals:
+	//! @brief Emitted in the GUI thread when a @ref request is done.
+	void ready();
+
+	protected:
+	SpriteCache();
+	virtual ~SpriteCache();
+
+	//! @brief Source of a sprite.
+	struct Source {
+		//! @brief SVG document, empty if only a PNG is available.
+		QByteArray svg;
+		//! @brief Decoded PNG, used without Qt Svg.
+		QImage image;
+		//! @brief Digest of the source, invalidates on-disk entries on asset change.
+		QString digest;
+	};
+
+	//! @brief Gets the source of a sprite, loading it on first use.
+	//! @return nullptr if there is none.
+	std::shared_ptr<const Source> _source(const QString& name);
+	//! @brief Renders a sprite from its source.
+	static QImage _rasterize(const Source& source, QSize size);
+	//! @brief Removes on-disk caches of previous versions.
+	void _removeStaleDirectories();
+
+	mutable QMutex _mutex;
+	//! @brief Loaded sources, nullptr if a name has none.
+	QHash<QString, std::shared_ptr<const Source>> _sources;
+	//! @brief Rasterized sprites, keyed by name and size, cost in KiB.
+	QCache<QString, QImage> _images;
+	QString _directory;
+	QThreadPool _pool;
+	//! @brief Identifier of the last request, older pending ones are skipped.
+	std::atomic<int> _generation;
+};
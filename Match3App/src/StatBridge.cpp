@@ -0,0 +1,112 @@
+//! @file
+
+#include "StatBridge.hpp"
+
+#include <QTimerEvent>
+#include <algorithm>
+
+namespace {
+//! @brief Frame period in milliseconds (i.e. ~60 fps).
+constexpr int kFrameInterval = 16;
+} // namespace
+
+StatBridge::StatBridge(QObject* parent)
+  : QObject(parent)
+  , _bindings()
+  , _connections()
+  , _clock()
+  , _duration(300)
+  , _timerId(0) {
+	_clock.start();
+}
+
+StatBridge::~StatBridge() {
+	clear();
+}
+
+void
+StatBridge::bind(Signal::Signal<std::size_t>& source, std::size_t value, StatWidget* widget) {
+	const std::size_t index = _bindings.size();
+	_bindings.push_back({widget, value, value, value, 0, false});
+	widget->setText(QString::number(value));
+	_connections += source.connect([this, index](std::size_t val) { _set(index, val); });
+}
+
+void
+StatBridge::clear() {
+	_connections.disconnect();
+	_bindings.clear();
+	if (_timerId != 0) {
+		killTimer(_timerId);
+		_timerId = 0;
+	}
+}
+
+int
+StatBridge::duration() const noexcept {
+	return _duration;
+}
+
+void
+StatBridge::setDuration(int msec) {
+	_duration = std::max(0, msec);
+}
+
+void
+StatBridge::flush() {
+	for (Binding& binding : _bindings) {
+		if (!binding.pending) continue;
+		_show(binding, binding.target);
+		binding.pending = false;
+	}
+	if (_timerId != 0) {
+		killTimer(_timerId);
+		_timerId = 0;
+	}
+}
+
+void
+StatBridge::timerEvent(QTimerEvent* event) {
+	if (event->timerId() != _timerId) {
+		QObject::timerEvent(event);
+		return;
+	}
+	const qint64 now = _clock.elapsed();
+	bool running     = false;
+	for (Binding& binding : _bindings) {
+		if (!binding.pending) continue;
+		const qint64 elapsed = now - binding.start;
+		if (_duration == 0 || elapsed >= _duration) {
+			_show(binding, binding.target);
+			binding.pending = false;
+			continue;
+		}
+		// Count from the value displayed when the target was received.
+		const double progress = double(elapsed) / double(_duration);
+		const double from     = double(binding.from);
+		const double delta    = double(binding.target) - from;
+		_show(binding, std::size_t(from + delta * progress));
+		running = true;
+	}
+	if (!running) {
+		killTimer(_timerId);
+		_timerId = 0;
+	}
+}
+
+void
+StatBridge::_set(std::size_t index, std::size_t value) {
+	Binding& binding = _bindings[index];
+	binding.from     = binding.shown;
+	binding.target   = value;
+	binding.start    = _clock.elapsed();
+	binding.pending  = binding.shown != value;
+	if (binding.pending && _timerId == 0) _timerId = startTimer(kFrameInterval, Qt::PreciseTimer);
+}
+
+void
+StatBridge::_show(Binding& binding, std::size_t value) {
+	if (value == binding.shown) return;
+	binding.shown = value;
+	binding.widget->setText(QString::number(value));
+}
@@ -0,0 +1,72 @@
+//! @file
+#pragma once
+
+#include "StatWidget.hpp"
+#include <QElapsedTimer>
+#include <QObject>
+#include <Signal/Connection.hpp>
+#include <Signal/Signal.hpp>
+#include <vector>
+
+//! @brief Forwards model counters (e.g. score) to StatWidgets, at most once per frame.
+//! @details A change only stores the new value, the widgets are updated by a
+//! single frame timer which runs while a value is pending or counting up.
+//! Thus a cascade changing the score dozens of times costs one relayout, and
+//! no change allocates.
+//! @note Sources must be emitted from the GUI thread.
+class StatBridge : public QObject {
+	Q_OBJECT
+
+	public:
+	StatBridge(QObject* parent = 0);
+	virtual ~StatBridge();
+	StatBridge(const StatBridge&) = delete;
+	StatBridge& operator=(const StatBridge&) = delete;
+
+	//! @brief Displays a counter in a widget.
+	//! @param[in] source Signal emitted with the new value, must outlive the
+	//! bridge or be disconnected with @ref clear.
+	//! @param[in] value Current value, displayed right away.
+	//! @param[in] widget The widget updated, must outlive the bridge.
+	void bind(Signal::Signal<std::size_t>& source, std::size_t value, StatWidget* widget);
+	//! @brief Removes all bindings.
+	void clear();
+
+	//! @brief Gets the count-up duration in milliseconds.
+	int duration() const noexcept;
+	//! @brief Sets the count-up duration in milliseconds, 0 to show new values
+	//! as is (default 300 ms).
+	void setDuration(int msec);
+
+	//! @brief Displays all pending values now, skipping the count-up.
+	void flush();
+
+	protected:
+	void timerEvent(QTimerEvent* event) override;
+
+	//! @brief State of a bound widget.
+	struct Binding {
+		StatWidget* widget;
+		//! @brief Last value received.
+		std::size_t target;
+		//! @brief Value displayed when target was received.
+		std::size_t from;
+		//! @brief Value displayed.
+		std::size_t shown;
+		//! @brief Time target was received in milliseconds.
+		qint64 start;
+		//! @brief Display differs from target.
+		bool pending;
+	};
+
+	//! @brief Records a new value.
+	void _set(std::size_t index, std::size_t value);
+	//! @brief Sets the text of a widget if the value displayed changes.
+	static void _show(Binding& binding, std::size_t value);
+
+	std::vector<Binding> _bindings;
+	Signal::ScopedConnectionGroup _connections;
+	QElapsedTimer _clock;
+	int _duration;
+	int _timerId;
+};
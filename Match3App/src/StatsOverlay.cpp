@@ -0,0 +1,83 @@
+//! @file
+
+#include "StatsOverlay.hpp"
+
+#include <QGraphicsScene>
+#include <chrono>
+
+namespace {
+//! @brief Refresh period of the text in milliseconds.
+constexpr int kRefreshInterval = 500;
+
+//! @brief Formats a duration in milliseconds.
+QString
+ms(qint64 nsecs) {
+	return QString::number(double(nsecs) / 1e6, 'f', 2) + " ms";
+}
+
+QString
+ms(std::chrono::nanoseconds duration) {
+	return ms(qint64(duration.count()));
+}
+} // namespace
+
+StatsOverlay::StatsOverlay(const match3::Game& game, BoardView* view)
+  : QLabel(view->viewport())
+  , _game(game)
+  , _view(view)
+  , _timer() {
+	setObjectName("StatsOverlay");
+	// Opaque, so updating the text doesn't repaint the board below.
+	setAutoFillBackground(true);
+	setStyleSheet(
+	  "QLabel {"
+	  "background-color: black;"
+	  "color: lime;"
+	  "font: 11px monospace;"
+	  "padding: 4px;"
+	  "}");
+	setAttribute(Qt::WA_TransparentForMouseEvents);
+	move(4, 4);
+	_timer.setInterval(kRefreshInterval);
+	connect(&_timer, &QTimer::timeout, this, &StatsOverlay::refresh);
+	hide();
+}
+
+void
+StatsOverlay::refresh() {
+	const FrameStats& frames            = _view->frameStats();
+	const match3::Game::TurnStats& turn = _game.lastTurn();
+	QStringList lines;
+	lines << QString("FPS %1  frame p50 %2  p99 %3")
+	           .arg(frames.fps(), 0, 'f', 1)
+	           .arg(ms(frames.percentile(0.50)))
+	           .arg(ms(frames.percentile(0.99)));
+	lines << QString("scene items %1").arg(_view->scene()->items().size());
+	lines << QString("turn: swap %1  match %2  settle %3  refill %4  deadlock %5")
+	           .arg(ms(turn.swap))
+	           .arg(ms(turn.match))
+	           .arg(ms(turn.settle))
+	           .arg(ms(turn.refill))
+	           .arg(ms(turn.deadlock));
+	lines << QString("      %1 removed, %2 added in %3 round(s)")
+	           .arg(turn.removed)
+	           .arg(turn.added)
+	           .arg(turn.rounds);
+	setText(lines.join('\n'));
+	adjustSize();
+}
+
+void
+StatsOverlay::showEvent(QShowEvent* event) {
+	_view->setFrameTiming(true);
+	refresh();
+	_timer.start();
+	QLabel::showEvent(event);
+}
+
+void
+StatsOverlay::hideEvent(QHideEvent* event) {
+	_timer.stop();
+	_view->setFrameTiming(false);
+	QLabel::hideEvent(event);
+}
@@ -0,0 +1,37 @@
+//! @file
+#pragma once
+
+#include "BoardView.hpp"
+#include <Match3/Game.hpp>
+#include <QLabel>
+#include <QTimer>
+
+//! @brief Diagnostic panel drawn over a BoardView.
+//! @details Shows the FPS, frame time p50/p99, scene item count and the
+//! engine time of the last move by phase. Frames are only timed while the
+//! overlay is visible, and the text is refreshed twice per second to not
+//! disturb what it measures.
+class StatsOverlay : public QLabel {
+	Q_OBJECT
+
+	public:
+	//! @param[in] game Game whose last move is reported, must outlive the overlay.
+	//! @param[in] view View whose frames are timed, the overlay is drawn over
+	//! its viewport.
+	StatsOverlay(const match3::Game& game, BoardView* view);
+	virtual ~StatsOverlay() = default;
+	StatsOverlay(const StatsOverlay&) = delete;
+	StatsOverlay& operator=(const StatsOverlay&) = delete;
+
+	public slots:
+	//! @brief Updates the displayed statistics.
+	void refresh();
+
+	protected:
+	virtual void showEvent(QShowEvent* event) override;
+	virtual void hideEvent(QHideEvent* event) override;
+
+	const match3::Game& _game;
+	BoardView* _view;
+	QTimer _timer;
+};
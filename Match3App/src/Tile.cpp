@@ -4,13 +4,13 @@
 #include <QGraphicsSceneEvent>
 #include <QMimeData>
 #include <QPainter>
-#include <QPixmapCache>
 
 #include "BoardView.hpp"
 
-Tile::Tile(const match3::ConstCellPtr& cell, QGraphicsItem* parent)
+Tile::Tile(const match3::ConstCellPtr& cell, const SpriteAtlas& atlas, QGraphicsItem* parent)
   : QGraphicsObject(parent)
   , _cell(cell)
+  , _atlas(atlas)
   , _dragOver(false) {
 	setPos(_cell->position.get().x(), _cell->position.get().y());
 	setTransformOriginPoint(0.5, 0.5);
@@ -26,9 +26,9 @@ Tile::boundingRect() const {
 void
 Tile::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
 	painter->setRenderHint(QPainter::Antialiasing);
-	painter->setRenderHint(QPainter::SmoothPixmapTransform);
 
-	painter->drawPixmap(QRect(0, 0, 1, 1), pixmap());
+	// Atlas is rasterized at the tile size, so no smooth scaling is needed.
+	painter->drawPixmap(boundingRect(), _atlas.pixmap(), _atlas.tileSource());
 
 	// Draw "NoEntry" sign if Drop forbidden
 	if (!acceptDrops()) {
@@ -48,16 +48,6 @@ Tile::paint(QPainter* painter, const QStyleOptionGraphicsItem*, QWidget*) {
 	}
 }
 
-QPixmap
-Tile::pixmap() {
-	QPixmap pm;
-	if (!QPixmapCache::find("tile", &pm)) {
-		pm.load(":/img/tile.png");
-		QPixmapCache::insert("tile", pm);
-	}
-	return pm;
-}
-
 void
 Tile::dragEnterEvent(QGraphicsSceneDragDropEvent* event) {
 	if (event->mimeData()->hasFormat("application/x-items")) {
@@ -1,21 +1,23 @@
 //! @file
 #pragma once
 
+#include "SpriteAtlas.hpp"
 #include <Match3/Cell.hpp>
 #include <QGraphicsObject>
 
 class Tile : public QGraphicsObject {
 	public:
-	Tile(const match3::ConstCellPtr& cell, QGraphicsItem* parent = 0);
+	//! @param[in] cell The cell displayed.
+	//! @param[in] atlas Sprites, must outlive the tile.
+	Tile(const match3::ConstCellPtr& cell, const SpriteAtlas& atlas, QGraphicsItem* parent = 0);
 	virtual ~Tile() = default;
 
 	QRectF boundingRect() const override;
 	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*) override;
 
-	QPixmap pixmap();
-
 	protected:
 	const match3::ConstCellPtr _cell;
+	const SpriteAtlas& _atlas;
 
 	//! @brief Call when DragDrop item enter in the bounding rect of this object.
 	void dragEnterEvent(QGraphicsSceneDragDropEvent* event) override;
@@ -1,12 +1,15 @@
 #include <QApplication>
 
 #include "GameWidget.hpp"
+#include "SpriteCache.hpp"
 
 int
 main(int argc, char* argv[]) {
 	QApplication app(argc, argv);
 	app.setOrganizationName("Mizux");
 	app.setApplicationName("Match3");
+	// Decodes the sprite sources while the widgets are built.
+	SpriteCache::instance().preload();
 
 	// MainWindow main;
 	GameWidget main;
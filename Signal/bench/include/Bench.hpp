@@ -0,0 +1,314 @@
+//! @file
+//! @brief Minimal benchmark harness shared by the *_bench executables.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+//! @brief Clock used for all measurements.
+using Clock = std::chrono::steady_clock;
+
+//! @brief Prevents the compiler from optimizing away a value.
+template <typename T>
+inline void
+doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
+
+//! @brief Command line options common to all benchmarks.
+struct Options {
+	//! @brief Number of untimed runs before measuring.
+	std::size_t warmup = 3;
+	//! @brief Number of timed runs.
+	std::size_t repetitions = 15;
+	//! @brief Only run benchmarks whose name contains this string.
+	std::string filter;
+	//! @brief JSON output file, stdout if empty.
+	std::string output;
+	//! @brief Reduce problem sizes and runs (e.g. for a CI smoke test).
+	bool quick = false;
+	//! @brief Previous JSON output to compare with, no comparison if empty.
+	std::string baseline;
+	//! @brief Relative median slowdown above which a benchmark is reported as a regression.
+	double threshold = 0.10;
+	//! @brief Extra arguments not handled by the harness.
+	std::vector<std::string> extra;
+
+	//! @brief Parses the command line.
+	//! @throw std::invalid_argument on missing value.
+	static Options parse(int argc, char** argv) {
+		Options opts;
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			auto value            = [&]() -> std::string {
+				if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+				return argv[++i];
+			};
+			if (arg == "--warmup") {
+				opts.warmup = std::stoul(value());
+			} else if (arg == "--repetitions") {
+				opts.repetitions = std::max<std::size_t>(1, std::stoul(value()));
+			} else if (arg == "--filter") {
+				opts.filter = value();
+			} else if (arg == "--output") {
+				opts.output = value();
+			} else if (arg == "--baseline") {
+				opts.baseline = value();
+			} else if (arg == "--threshold") {
+				opts.threshold = std::stod(value());
+			} else if (arg == "--quick") {
+				opts.quick       = true;
+				opts.warmup      = 1;
+				opts.repetitions = 3;
+			} else {
+				opts.extra.push_back(arg);
+			}
+		}
+		return opts;
+	}
+};
+
+//! @brief Statistics of one benchmark, all durations are in nanoseconds per operation.
+struct Result {
+	std::string name;
+	//! @brief Number of operations per run.
+	std::size_t ops;
+	std::vector<double> samples;
+	double min;
+	double median;
+	double p99;
+	double mean;
+	double stddev;
+
+	//! @brief Computes the statistics from the samples.
+	void compute() {
+		std::vector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+		const std::size_t n = sorted.size();
+		min                 = sorted.front();
+		median = (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.;
+		// nearest-rank percentile
+		p99 = sorted[std::min(n - 1, std::size_t(std::ceil(0.99 * double(n))) - 1)];
+		double sum = 0.;
+		for (double s : sorted)
+			sum += s;
+		mean       = sum / double(n);
+		double var = 0.;
+		for (double s : sorted)
+			var += (s - mean) * (s - mean);
+		stddev = std::sqrt(var / double(n));
+	}
+};
+
+//! @brief Runs benchmarks and collects their results.
+class Runner {
+	public:
+	//! @brief Builds a runner.
+	//! @param[in] suite Name of the suite, reported in the JSON output.
+	//! @param[in] options Options to use.
+	Runner(std::string suite, Options options)
+	  : _suite(std::move(suite))
+	  , _options(std::move(options))
+	  , _results()
+	  , _metrics()
+	  , _skipped() {}
+
+	//! @brief Gets the options in use.
+	const Options& options() const noexcept { return _options; }
+
+	//! @brief Runs and times a benchmark.
+	//! @param[in] name Benchmark name, must be unique.
+	//! @param[in] ops Number of operations performed by one body call.
+	//! @param[in] setup Untimed function called before each body call.
+	//! @param[in] body Timed function.
+	//! @return The result (valid until the next run), nullptr if the benchmark is
+	//! filtered out.
+	const Result* run(
+	  const std::string& name,
+	  std::size_t ops,
+	  const std::function<void()>& setup,
+	  const std::function<void()>& body) {
+		if (!selected(name)) return nullptr;
+
+		Result result{name, std::max<std::size_t>(1, ops), {}, 0, 0, 0, 0, 0};
+		for (std::size_t i = 0; i < _options.warmup; ++i) {
+			setup();
+			body();
+		}
+		result.samples.reserve(_options.repetitions);
+		for (std::size_t i = 0; i < _options.repetitions; ++i) {
+			setup();
+			const Clock::time_point before = Clock::now();
+			body();
+			const Clock::time_point after = Clock::now();
+			result.samples.push_back(
+			  double(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count()) /
+			  double(result.ops));
+		}
+		result.compute();
+		std::cerr << std::left << std::setw(48) << name << std::right << " median "
+		          << std::setw(12) << std::fixed << std::setprecision(2) << result.median
+		          << " ns/op, p99 " << std::setw(12) << result.p99 << " ns/op" << std::endl;
+		_results.push_back(std::move(result));
+		return &_results.back();
+	}
+	//! @copydoc run(const std::string&, std::size_t, const std::function<void()>&, const std::function<void()>&)
+	const Result* run(const std::string& name, std::size_t ops, const std::function<void()>& body) {
+		return run(name, ops, []() {}, body);
+	}
+
+	//! @brief Checks if a benchmark passes the name filter.
+	bool selected(const std::string& name) const {
+		return _options.filter.empty() || name.find(_options.filter) != std::string::npos;
+	}
+	//! @brief Records a benchmark which was not run.
+	//! @param[in] name Benchmark name.
+	//! @param[in] reason Why it was skipped.
+	void skip(const std::string& name, const std::string& reason) {
+		if (!selected(name)) return;
+		std::cerr << std::left << std::setw(48) << name << " skipped: " << reason << std::endl;
+		_skipped.emplace_back(name, reason);
+	}
+
+	//! @brief Records a value which is not a timing (e.g. peak memory).
+	//! @param[in] name Metric name, must be unique.
+	//! @param[in] value The measured value.
+	//! @param[in] unit Unit of value.
+	void metric(const std::string& name, double value, const std::string& unit) {
+		if (!selected(name)) return;
+		std::cerr << std::left << std::setw(48) << name << std::right << " " << std::setw(12)
+		          << std::fixed << std::setprecision(2) << value << " " << unit << std::endl;
+		_metrics.push_back({name, value, unit});
+	}
+
+	//! @brief Gets the collected results.
+	const std::vector<Result>& results() const noexcept { return _results; }
+
+	//! @brief Loads the medians of a previous JSON output.
+	//! @param[in] path File written by @ref report.
+	//! @return Median per benchmark name.
+	//! @throw std::runtime_error if the file can't be read.
+	static std::map<std::string, double> loadMedians(const std::string& path) {
+		std::ifstream file(path);
+		if (!file) throw std::runtime_error("Can't open " + path);
+		// writeJson emits one result per line, no need for a full JSON parser.
+		std::map<std::string, double> medians;
+		std::string line;
+		while (std::getline(file, line)) {
+			const std::size_t name   = line.find("\"name\": \"");
+			const std::size_t median = line.find("\"median\": ");
+			if (name == std::string::npos || median == std::string::npos) continue;
+			const std::size_t begin = name + 9;
+			const std::size_t end   = line.find('"', begin);
+			medians[line.substr(begin, end - begin)] = std::stod(line.substr(median + 10));
+		}
+		return medians;
+	}
+
+	//! @brief Compares the results with the baseline file given in options.
+	//! @return EXIT_FAILURE if at least one benchmark is slower than the
+	//! threshold allows, EXIT_SUCCESS otherwise (or if there is no baseline).
+	int compare() const {
+		if (_options.baseline.empty()) return EXIT_SUCCESS;
+		const std::map<std::string, double> baseline = loadMedians(_options.baseline);
+		std::size_t regressions                      = 0;
+		for (const Result& r : _results) {
+			auto it = baseline.find(r.name);
+			if (it == baseline.end() || it->second <= 0.) continue;
+			const double ratio = r.median / it->second;
+			const bool slower  = ratio > 1. + _options.threshold;
+			regressions += slower;
+			std::cerr << std::left << std::setw(48) << r.name << std::right << " x" << std::fixed
+			          << std::setprecision(3) << ratio << (slower ? "  REGRESSION" : "") << std::endl;
+		}
+		std::cerr << regressions << " regression(s) above " << _options.threshold * 100.
+		          << "% against " << _options.baseline << std::endl;
+		return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	//! @brief Writes the results as JSON.
+	void writeJson(std::ostream& os) const {
+		os << "{\n";
+		os << "  \"suite\": \"" << _suite << "\",\n";
+		os << "  \"warmup\": " << _options.warmup << ",\n";
+		os << "  \"repetitions\": " << _options.repetitions << ",\n";
+		os << "  \"unit\": \"ns/op\",\n";
+		os << "  \"results\": [";
+		os << std::setprecision(3) << std::fixed;
+		for (std::size_t i = 0; i < _results.size(); ++i) {
+			const Result& r = _results[i];
+			os << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"ops\": " << r.ops
+			   << ", \"min\": " << r.min << ", \"median\": " << r.median << ", \"p99\": " << r.p99
+			   << ", \"mean\": " << r.mean << ", \"stddev\": " << r.stddev << ", \"samples\": [";
+			for (std::size_t j = 0; j < r.samples.size(); ++j) {
+				os << (j ? ", " : "") << r.samples[j];
+			}
+			os << "]}";
+		}
+		os << "\n  ],\n";
+		os << "  \"metrics\": [";
+		for (std::size_t i = 0; i < _metrics.size(); ++i) {
+			os << (i ? ",\n" : "\n") << "    {\"name\": \"" << _metrics[i].name
+			   << "\", \"value\": " << _metrics[i].value << ", \"unit\": \"" << _metrics[i].unit
+			   << "\"}";
+		}
+		os << "\n  ],\n";
+		os << "  \"skipped\": [";
+		for (std::size_t i = 0; i < _skipped.size(); ++i) {
+			os << (i ? ",\n" : "\n") << "    {\"name\": \"" << _skipped[i].first
+			   << "\", \"reason\": \"" << _skipped[i].second << "\"}";
+		}
+		os << "\n  ]\n}\n";
+	}
+
+	//! @brief Writes the JSON results to the output file (or stdout), then
+	//! compares them with the baseline if any.
+	//! @return EXIT_SUCCESS, or EXIT_FAILURE if the file can't be written or on
+	//! regression.
+	int report() const {
+		if (_options.output.empty()) {
+			writeJson(std::cout);
+		} else {
+			std::ofstream file(_options.output);
+			if (!file) {
+				std::cerr << "Can't open " << _options.output << std::endl;
+				return EXIT_FAILURE;
+			}
+			writeJson(file);
+		}
+		return compare();
+	}
+
+	private:
+	struct Metric {
+		std::string name;
+		double value;
+		std::string unit;
+	};
+
+	std::string _suite;
+	Options _options;
+	std::vector<Result> _results;
+	std::vector<Metric> _metrics;
+	std::vector<std::pair<std::string, std::string>> _skipped;
+};
+} // namespace bench
@@ -0,0 +1,212 @@
+//! @file
+//! @brief Signal library benchmarks, results are written as JSON.
+//! @details usage: Signal_bench [--quick] [--warmup N] [--repetitions N]
+//! [--filter NAME] [--output FILE]
+#include <Bench.hpp>
+#include <Signal/EventLoop.hpp>
+#include <Signal/Property.hpp>
+#include <Signal/Signal.hpp>
+#include <Signal/StaticSignal.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+int g_value;
+
+void
+freeFunction(const int& val) {
+	g_value += val;
+}
+
+void
+benchConnection(bench::Runner& runner, std::size_t count) {
+	const std::string suffix = "/" + std::to_string(count);
+	std::unique_ptr<Signal::Signal<int>> sig;
+	std::vector<Signal::Connection> connections;
+	Signal::ScopedConnectionGroup group;
+
+	runner.run(
+	  "connect" + suffix,
+	  count,
+	  [&]() {
+		  connections.clear();
+		  sig = std::make_unique<Signal::Signal<int>>();
+		  connections.reserve(count);
+	  },
+	  [&]() {
+		  for (std::size_t i = 0; i < count; ++i) {
+			  connections.push_back(sig->connect(&freeFunction));
+		  }
+	  });
+
+	runner.run(
+	  "disconnect" + suffix,
+	  count,
+	  [&]() {
+		  connections.clear();
+		  sig = std::make_unique<Signal::Signal<int>>();
+		  for (std::size_t i = 0; i < count; ++i) {
+			  connections.push_back(sig->connect(&freeFunction));
+		  }
+	  },
+	  [&]() {
+		  for (auto& connection : connections) {
+			  connection.disconnect();
+		  }
+	  });
+
+	runner.run(
+	  "disconnect_group" + suffix,
+	  count,
+	  [&]() {
+		  group.disconnect();
+		  sig = std::make_unique<Signal::Signal<int>>();
+		  group.reserve(count);
+		  for (std::size_t i = 0; i < count; ++i) {
+			  group += sig->connect(&freeFunction);
+		  }
+	  },
+	  [&]() { group.disconnect(); });
+	connections.clear();
+}
+
+void
+benchEmit(bench::Runner& runner, std::size_t observers, std::size_t loop) {
+	Signal::Signal<int> sig;
+	std::vector<Signal::Connection> connections;
+	for (std::size_t i = 0; i < observers; ++i) {
+		connections.push_back(sig.connect(&freeFunction));
+	}
+	runner.run("emit/" + std::to_string(observers), loop, [&]() {
+		for (std::size_t i = 0; i < loop; ++i) {
+			sig.emit(1);
+		}
+	});
+}
+
+void
+benchCallPaths(bench::Runner& runner, std::size_t loop) {
+	runner.run("call/raw", loop, [&]() {
+		for (std::size_t i = 0; i < loop; ++i) {
+			freeFunction(1);
+			bench::doNotOptimize(g_value);
+		}
+	});
+	runner.run("call/static", loop, [&]() {
+		for (std::size_t i = 0; i < loop; ++i) {
+			Signal::StaticSignal<int>::with<&freeFunction>::emit(1);
+			bench::doNotOptimize(g_value);
+		}
+	});
+	Signal::Signal<int> sig;
+	auto c = sig.connect(&freeFunction);
+	runner.run("call/dynamic", loop, [&]() {
+		for (std::size_t i = 0; i < loop; ++i) {
+			sig.emit(1);
+			bench::doNotOptimize(g_value);
+		}
+	});
+}
+
+void
+benchProperty(bench::Runner& runner, std::size_t observers, std::size_t loop) {
+	Signal::Property<int> prop(0);
+	std::vector<Signal::Connection> connections;
+	for (std::size_t i = 0; i < observers; ++i) {
+		connections.push_back(prop.connect(&freeFunction));
+	}
+	runner.run("property_set/" + std::to_string(observers), loop, [&]() {
+		for (std::size_t i = 0; i < loop; ++i) {
+			prop.set(int(i));
+		}
+	});
+	runner.run("property_get/" + std::to_string(observers), loop, [&]() {
+		int sum = 0;
+		for (std::size_t i = 0; i < loop; ++i) {
+			sum += prop.get();
+			bench::doNotOptimize(sum);
+		}
+	});
+}
+
+//! @brief Several threads emitting concurrently on the same Signal.
+void
+benchMultiThreadEmit(bench::Runner& runner, std::size_t threads, std::size_t loop) {
+	Signal::Signal<int> sig;
+	std::atomic<int> counter(0);
+	auto c = sig.connect([&counter](int val) { counter.fetch_add(val, std::memory_order_relaxed); });
+	runner.run("emit_mt/" + std::to_string(threads), threads * loop, [&]() {
+		std::vector<std::thread> pool;
+		for (std::size_t t = 0; t < threads; ++t) {
+			pool.emplace_back([&]() {
+				for (std::size_t i = 0; i < loop; ++i) {
+					sig.emit(1);
+				}
+			});
+		}
+		for (auto& thread : pool) {
+			thread.join();
+		}
+	});
+}
+
+//! @brief Producer threads emitting on a queued connection drained by a loop thread.
+void
+benchQueued(bench::Runner& runner, std::size_t producers, std::size_t loop) {
+	Signal::EventLoop eventLoop(256);
+	Signal::Signal<int> sig;
+	int sum = 0;
+	auto c  = sig.connect(eventLoop, [&sum](int val) { sum += val; });
+	runner.run("emit_queued/" + std::to_string(producers), producers * loop, [&]() {
+		std::thread consumer([&]() { eventLoop.exec(); });
+		std::vector<std::thread> pool;
+		for (std::size_t t = 0; t < producers; ++t) {
+			pool.emplace_back([&]() {
+				for (std::size_t i = 0; i < loop; ++i) {
+					sig.emit(1);
+				}
+			});
+		}
+		for (auto& thread : pool) {
+			thread.join();
+		}
+		eventLoop.quit();
+		consumer.join();
+	});
+	bench::doNotOptimize(sum);
+	const Signal::EventLoop::Stats stats = eventLoop.stats();
+	if (stats.processed == 0) return;
+	std::cerr << "  queued latency: mean "
+	          << (stats.processed ? stats.totalLatency.count() / std::int64_t(stats.processed) : 0)
+	          << " ns, max " << stats.maxLatency.count() << " ns" << std::endl;
+}
+} // namespace
+
+int
+main(int argc, char** argv) {
+	bench::Runner runner("Signal", bench::Options::parse(argc, argv));
+	const bool quick      = runner.options().quick;
+	const std::size_t n   = quick ? 1'000 : 100'000;
+	const std::size_t emt = quick ? 1'000 : 200'000;
+
+	for (std::size_t count : {std::size_t(16), std::size_t(1'000)}) {
+		benchConnection(runner, count);
+	}
+	for (std::size_t observers : {0, 1, 8, 64, 512}) {
+		benchEmit(runner, observers, observers > 8 ? n / observers : n);
+	}
+	benchCallPaths(runner, n);
+	for (std::size_t observers : {0, 1, 8}) {
+		benchProperty(runner, observers, n);
+	}
+	for (std::size_t threads : {1, 2, 4}) {
+		benchMultiThreadEmit(runner, threads, emt);
+	}
+	for (std::size_t producers : {1, 2, 4}) {
+		benchQueued(runner, producers, emt / 4);
+	}
+	return runner.report();
+}
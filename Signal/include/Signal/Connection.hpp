@@ -1,26 +1,145 @@
 //! @file
 #pragma once
 
-#include <functional>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace Signal {
 
+//! @brief Common base of Signal and Property implementations.
+//! @details Let a Connection disconnect its observer without knowing the
+//! observer signature.
+class SlotTable {
+	public:
+	virtual ~SlotTable() = default;
+
+	//! @brief Removes one observer.
+	//! @param[in] uid Identifier returned on connection.
+	virtual void disconnect(std::uint32_t uid) = 0;
+	//! @brief Removes several observers.
+	//! @param[in] uids Identifiers returned on connection.
+	virtual void disconnect(std::span<const std::uint32_t> uids) {
+		for (std::uint32_t uid : uids) {
+			disconnect(uid);
+		}
+	}
+};
+
 //! @brief Save connection between on Observer and a Signal or Property.
 //! @details Will automatically destroy the connection at object destruction.
+//! Only stores a weak pointer on the slot table and the observer id, thus
+//! creating a Connection doesn't allocate.
 class Connection {
+	friend class ScopedConnectionGroup;
+
 	public:
-	Connection(std::function<void(void)>&& deconnector)
-	  : _deconnector(deconnector) {}
+	//! @brief Builds a closed connection.
+	Connection() = default;
+	//! @brief Builds a connection.
+	//! @param[in] table Slot table owning the observer.
+	//! @param[in] uid Identifier of the observer in the table.
+	Connection(std::weak_ptr<SlotTable> table, std::uint32_t uid)
+	  : _table(std::move(table))
+	  , _uid(uid) {}
 	Connection(const Connection&) = delete;             // no cpyable
 	Connection& operator=(const Connection&) = delete;  // no cpy op
 	Connection(Connection&&)                 = default; // movable
-	Connection& operator=(Connection&&) = default;      // movable op
+	Connection& operator=(Connection&& other) {         // movable op
+		if (this != &other) {
+			disconnect();
+			_table = std::move(other._table);
+			_uid   = other._uid;
+		}
+		return *this;
+	}
 
 	~Connection() { disconnect(); }
 
-	inline void disconnect() const { _deconnector(); }
+	//! @brief Removes the observer, if the Signal or Property is still alive.
+	inline void disconnect() const {
+		auto sp = _table.lock();
+		if (sp != nullptr) {
+			sp->disconnect(_uid);
+		}
+		_table.reset();
+	}
+
+	//! @brief Checks if the connection is still open.
+	//! @return false if disconnected or if the Signal or Property is destroyed.
+	inline bool connected() const noexcept { return !_table.expired(); }
+
+	private:
+	//! @brief Slot table, mutable so a const connection can be closed.
+	mutable std::weak_ptr<SlotTable> _table;
+	std::uint32_t _uid = 0;
+};
+
+//! @brief Stores many connections and closes them all at once.
+//! @details Connections to the same Signal or Property which are added one
+//! after the other are removed with a single call on the slot table.
+class ScopedConnectionGroup {
+	public:
+	ScopedConnectionGroup() = default;
+	ScopedConnectionGroup(const ScopedConnectionGroup&) = delete;            // no cpyable
+	ScopedConnectionGroup& operator=(const ScopedConnectionGroup&) = delete; // no cpy op
+	ScopedConnectionGroup(ScopedConnectionGroup&&)                 = default; // movable
+	ScopedConnectionGroup& operator=(ScopedConnectionGroup&& other) {        // movable op
+		if (this != &other) {
+			disconnect();
+			_connections = std::move(other._connections);
+		}
+		return *this;
+	}
+
+	~ScopedConnectionGroup() { disconnect(); }
+
+	//! @brief Takes ownership of a connection.
+	//! @param[in] connection The connection to store.
+	void add(Connection&& connection) { _connections.push_back(std::move(connection)); }
+	//! @copydoc add(Connection&&)
+	ScopedConnectionGroup& operator+=(Connection&& connection) {
+		add(std::move(connection));
+		return *this;
+	}
+	//! @brief Reserves storage for the specified number of connections.
+	void reserve(std::size_t size) { _connections.reserve(size); }
+
+	//! @brief Closes all stored connections.
+	void disconnect() {
+		std::vector<std::uint32_t> uids;
+		std::size_t first = 0;
+		while (first < _connections.size()) {
+			// Find the run of connections sharing the same table.
+			std::size_t last = first + 1;
+			while (last < _connections.size() &&
+			       !_connections[first]._table.owner_before(_connections[last]._table) &&
+			       !_connections[last]._table.owner_before(_connections[first]._table)) {
+				++last;
+			}
+			auto sp = _connections[first]._table.lock();
+			if (sp != nullptr) {
+				uids.clear();
+				for (std::size_t i = first; i < last; ++i) {
+					uids.push_back(_connections[i]._uid);
+				}
+				sp->disconnect(std::span<const std::uint32_t>(uids));
+			}
+			for (std::size_t i = first; i < last; ++i) {
+				_connections[i]._table.reset();
+			}
+			first = last;
+		}
+		_connections.clear();
+	}
+
+	//! @brief Gets the number of stored connections.
+	std::size_t size() const noexcept { return _connections.size(); }
+	//! @brief Checks if the group stores no connection.
+	bool empty() const noexcept { return _connections.empty(); }
 
 	private:
-	std::function<void(void)> _deconnector;
+	std::vector<Connection> _connections;
 };
 } // namespace Signal
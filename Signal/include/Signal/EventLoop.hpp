@@ -0,0 +1,116 @@
+//! @file
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace Signal {
+
+//! @brief Event loop used to deliver queued Signal emissions on its own thread.
+//! @details Any thread can @ref post a task, only the thread running
+//! @ref processEvents or @ref exec consumes them.
+//! Tasks are stored in a lock-free multi-producer single-consumer queue, thus
+//! producers never block on the consumer.
+class EventLoop {
+	public:
+	//! @brief Task type stored in the queue.
+	using Task = std::function<void(void)>;
+	//! @brief Clock used to measure the queue latency.
+	using Clock = std::chrono::steady_clock;
+
+	//! @brief Snapshot of the loop counters.
+	struct Stats {
+		//! @brief Number of tasks currently waiting in the queue.
+		std::size_t depth;
+		//! @brief Number of tasks posted since the last reset.
+		std::uint64_t posted;
+		//! @brief Number of tasks processed since the last reset.
+		std::uint64_t processed;
+		//! @brief Sum of the time spent in queue by processed tasks.
+		std::chrono::nanoseconds totalLatency;
+		//! @brief Longest time spent in queue by a processed task.
+		std::chrono::nanoseconds maxLatency;
+	};
+
+	//! @brief Builds an empty loop.
+	//! @param[in] maxBatchSize Maximum number of tasks processed per drain,
+	//! zero means no limit.
+	explicit EventLoop(std::size_t maxBatchSize = 0);
+	//! @brief Destroys the loop, pending tasks are dropped.
+	~EventLoop();
+	EventLoop(const EventLoop&) = delete;            // no cpyable
+	EventLoop& operator=(const EventLoop&) = delete; // no cpy op
+	EventLoop(EventLoop&&)                 = delete; // no movable
+	EventLoop& operator=(EventLoop&&) = delete;      // no movable op
+
+	//! @brief Enqueues a task, can be called from any thread.
+	//! @param[in] task The task to run on the loop thread.
+	void post(Task task);
+
+	//! @brief Runs pending tasks on the calling thread.
+	//! @details At most @ref maxBatchSize tasks are processed.
+	//! @return The number of tasks processed.
+	std::size_t processEvents();
+	//! @brief Runs pending tasks on the calling thread.
+	//! @param[in] maxBatchSize Maximum number of tasks to process, zero means no limit.
+	//! @return The number of tasks processed.
+	std::size_t processEvents(std::size_t maxBatchSize);
+
+	//! @brief Processes tasks until @ref quit is called.
+	//! @details The calling thread sleeps while the queue is empty.
+	void exec();
+	//! @brief Requests @ref exec to return once previously posted tasks are done.
+	void quit();
+
+	//! @brief Gets the maximum number of tasks processed per drain.
+	std::size_t maxBatchSize() const noexcept;
+	//! @brief Sets the maximum number of tasks processed per drain.
+	//! @param[in] maxBatchSize The new limit, zero means no limit.
+	void setMaxBatchSize(std::size_t maxBatchSize) noexcept;
+
+	//! @brief Gets the number of tasks currently waiting in the queue.
+	std::size_t depth() const noexcept;
+	//! @brief Gets a snapshot of the loop counters.
+	Stats stats() const noexcept;
+	//! @brief Resets posted, processed and latency counters.
+	void resetStats() noexcept;
+
+	private:
+	//! @brief Queue node.
+	struct Node {
+		std::atomic<Node*> next;
+		Task task;
+		Clock::time_point timestamp;
+	};
+
+	//! @brief Pops the oldest node.
+	//! @return The popped node, nullptr if the queue is empty (or a producer
+	//! is still linking its node).
+	Node* _pop();
+
+	//! @brief Last pushed node, producers side.
+	std::atomic<Node*> _head;
+	//! @brief Stub node preceding the oldest node, consumer side.
+	Node* _tail;
+
+	std::atomic<std::size_t> _maxBatchSize;
+	std::atomic<std::size_t> _depth;
+	std::atomic<bool> _running;
+
+	//! @brief Only used to sleep while the queue is empty.
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	std::atomic<bool> _sleeping;
+
+	std::atomic<std::uint64_t> _posted;
+	std::atomic<std::uint64_t> _processed;
+	std::atomic<std::int64_t> _totalLatency;
+	std::atomic<std::int64_t> _maxLatency;
+};
+} // namespace Signal
+
+#include "details/EventLoop.hxx"
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "Connection.hpp"
+#include "EventLoop.hpp"
 #include <functional>
 #include <memory>
 
@@ -15,6 +16,8 @@ class SignalImpl;
 //! - Be able to Disconnect at any time (even if signal has been destroy).
 //! Thus, I use a shared_ptr as PImpl so Connection can track with a weak_ptr if
 //! SignalImpl is still alive.
+//! - Observers are either called directly by @ref emit, or queued on an
+//! @ref EventLoop which will call them on its own thread.
 template <typename... T>
 class Signal {
 	public:
@@ -32,6 +35,22 @@ class Signal {
 	template <class U>
 	Connection connect(U* obj, void (U::*func)(const T&...));
 
+	//! @brief Connects an observer called on the loop thread.
+	//! @details @ref emit copies the arguments and posts the call on the loop,
+	//! thus the emitter never waits for the observer.
+	//! If the connection is closed before the loop processes the call, the call
+	//! is dropped.
+	//! @note The loop must outlive the connection.
+	//! @param[in] loop The loop which will call the observer.
+	//! @param[in] observer The observer to call.
+	template <class ObserverType>
+	Connection connect(EventLoop& loop, ObserverType&& observer);
+	//! @copydoc connect(EventLoop&, ObserverType&&)
+	//! @param[in] obj Instance on which func is called.
+	//! @param[in] func Member function to call.
+	template <class U>
+	Connection connect(EventLoop& loop, U* obj, void (U::*func)(const T&...));
+
 	template <class... CallArgs>
 	void emit(CallArgs&&... args) const;
 
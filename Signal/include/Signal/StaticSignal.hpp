@@ -0,0 +1,49 @@
+//! @file
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Signal {
+
+//! @brief Signal whose observers are known at compile time.
+//! @details Observers are free functions (or any constant invocable) given as
+//! template parameters, thus emit is a sequence of direct calls the compiler can
+//! inline, without allocation nor type erasure.
+//! e.g.:
+//! @code{.cpp}
+//! using ScoreChanged = Signal::StaticSignal<int>::with<&updateLabel, &log>;
+//! ScoreChanged::emit(42);
+//! @endcode
+//! @note There is no connection management, use @ref Signal for observers
+//! registered at runtime.
+template <typename... T>
+struct StaticSignal {
+	//! @brief Binds the observers.
+	//! @tparam Slots Observers called, in order, by @ref emit.
+	template <auto... Slots>
+	struct with {
+		static_assert(
+		  (std::is_invocable_v<decltype(Slots), const T&...> && ...),
+		  "StaticSignal observers must be callable with (const T&...)");
+
+		//! @brief Calls each observer in order.
+		//! @details Arguments are perfectly forwarded to the last observer, the
+		//! previous ones receive const references.
+		//! @param[in] args Arguments to pass to the observers.
+		template <class... CallArgs>
+		static void emit(CallArgs&&... args);
+
+		//! @brief Return the number of Observers.
+		static constexpr std::size_t size() noexcept { return sizeof...(Slots); }
+		//! @brief Checks if there is no Observer.
+		static constexpr bool empty() noexcept { return sizeof...(Slots) == 0; }
+
+		private:
+		template <auto First, auto... Rest, class... CallArgs>
+		static void _emit(CallArgs&&... args);
+	};
+};
+} // namespace Signal
+
+#include "details/StaticSignal.hxx"
@@ -0,0 +1,145 @@
+//! @file
+#pragma once
+
+#include "../EventLoop.hpp"
+
+#include <memory>
+
+namespace Signal {
+
+//! @details The queue is the intrusive MPSC queue of D. Vyukov: producers only
+//! exchange the head pointer then link the previous node, the consumer follows
+//! the next pointers from a stub node.
+inline EventLoop::EventLoop(std::size_t maxBatchSize)
+  : _head(new Node{{nullptr}, Task(), Clock::time_point()})
+  , _tail(_head.load())
+  , _maxBatchSize(maxBatchSize)
+  , _depth(0)
+  , _running(false)
+  , _mutex()
+  , _condition()
+  , _sleeping(false)
+  , _posted(0)
+  , _processed(0)
+  , _totalLatency(0)
+  , _maxLatency(0) {}
+
+inline EventLoop::~EventLoop() {
+	while (Node* node = _pop()) {
+		delete node;
+	}
+	delete _tail;
+}
+
+inline void
+EventLoop::post(Task task) {
+	// Count the task before publishing it, so the consumer can't see it
+	// processed before it is counted.
+	_depth.fetch_add(1);
+	_posted.fetch_add(1, std::memory_order_relaxed);
+
+	Node* node = new Node{{nullptr}, std::move(task), Clock::now()};
+	Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+	prev->next.store(node, std::memory_order_release);
+
+	// Only pay for the mutex when the consumer is (about to be) asleep.
+	if (_sleeping.load()) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_condition.notify_one();
+	}
+}
+
+inline std::size_t
+EventLoop::processEvents() {
+	return processEvents(_maxBatchSize.load(std::memory_order_relaxed));
+}
+
+inline std::size_t
+EventLoop::processEvents(std::size_t maxBatchSize) {
+	std::size_t count = 0;
+	while (maxBatchSize == 0 || count < maxBatchSize) {
+		std::unique_ptr<Node> node(_pop());
+		if (!node) break;
+
+		const std::int64_t latency =
+		  std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - node->timestamp)
+		    .count();
+		_totalLatency.fetch_add(latency, std::memory_order_relaxed);
+		// single consumer, so no need for a CAS loop.
+		if (latency > _maxLatency.load(std::memory_order_relaxed)) {
+			_maxLatency.store(latency, std::memory_order_relaxed);
+		}
+		_processed.fetch_add(1, std::memory_order_relaxed);
+		_depth.fetch_sub(1);
+
+		node->task();
+		++count;
+	}
+	return count;
+}
+
+inline void
+EventLoop::exec() {
+	_running.store(true);
+	while (_running.load()) {
+		if (processEvents() != 0) continue;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_sleeping.store(true);
+		_condition.wait(lock, [this]() { return _depth.load() != 0; });
+		_sleeping.store(false);
+	}
+}
+
+inline void
+EventLoop::quit() {
+	post([this]() { _running.store(false); });
+}
+
+inline std::size_t
+EventLoop::maxBatchSize() const noexcept {
+	return _maxBatchSize.load(std::memory_order_relaxed);
+}
+
+inline void
+EventLoop::setMaxBatchSize(std::size_t maxBatchSize) noexcept {
+	_maxBatchSize.store(maxBatchSize, std::memory_order_relaxed);
+}
+
+inline std::size_t
+EventLoop::depth() const noexcept {
+	return _depth.load(std::memory_order_relaxed);
+}
+
+inline EventLoop::Stats
+EventLoop::stats() const noexcept {
+	return Stats{
+	  _depth.load(std::memory_order_relaxed),
+	  _posted.load(std::memory_order_relaxed),
+	  _processed.load(std::memory_order_relaxed),
+	  std::chrono::nanoseconds(_totalLatency.load(std::memory_order_relaxed)),
+	  std::chrono::nanoseconds(_maxLatency.load(std::memory_order_relaxed))};
+}
+
+inline void
+EventLoop::resetStats() noexcept {
+	_posted.store(0, std::memory_order_relaxed);
+	_processed.store(0, std::memory_order_relaxed);
+	_totalLatency.store(0, std::memory_order_relaxed);
+	_maxLatency.store(0, std::memory_order_relaxed);
+}
+
+inline EventLoop::Node*
+EventLoop::_pop() {
+	Node* tail = _tail;
+	Node* next = tail->next.load(std::memory_order_acquire);
+	if (next == nullptr) return nullptr;
+
+	// next becomes the new stub, so move its payload in the old one and give it
+	// back to the caller.
+	tail->task      = std::move(next->task);
+	tail->timestamp = next->timestamp;
+	_tail           = next;
+	return tail;
+}
+} // namespace Signal
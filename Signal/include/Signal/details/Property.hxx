@@ -4,16 +4,20 @@
 #include "../Property.hpp"
 
 #include <cstdint>
+#include <span>
 #include <unordered_map>
 
 namespace Signal {
 
 template <typename T>
-class PropertyImpl {
+class PropertyImpl : public SlotTable {
 	public:
 	using Observer = std::function<void(const T&)>;
 
-	PropertyImpl() = default;
+	PropertyImpl()
+	  : _value()
+	  , _uid(0)
+	  , _observers() {}
 	explicit PropertyImpl(T value)
 	  : _value(std::move(value))
 	  , _uid(0)
@@ -28,7 +32,8 @@ class PropertyImpl {
 	std::uint32_t connect(ObserverType&& observer);
 	template <class U>
 	std::uint32_t connect(U* obj, void (U::*func)(const T&));
-	void disconnect(std::uint32_t uid);
+	void disconnect(std::uint32_t uid) override;
+	void disconnect(std::span<const std::uint32_t> uids) override;
 
 	const T& get() const;
 	void set(T value);
@@ -57,28 +62,14 @@ template <typename T>
 template <class ObserverType>
 Connection
 Property<T>::connect(ObserverType&& observer) {
-	std::uint32_t uid                 = this->_private->connect(observer);
-	std::weak_ptr<PropertyImpl<T>> wp = this->_private;
-	return Connection([=]() {
-		auto sp = wp.lock();
-		if (sp != nullptr) {
-			sp->disconnect(uid);
-		}
-	});
+	return Connection(this->_private, this->_private->connect(observer));
 }
 
 template <typename T>
 template <class U>
 Connection
 Property<T>::connect(U* obj, void (U::*func)(const T&)) {
-	std::uint32_t uid                 = this->_private->connect(obj, func);
-	std::weak_ptr<PropertyImpl<T>> wp = this->_private;
-	return Connection([=]() {
-		auto sp = wp.lock();
-		if (sp != nullptr) {
-			sp->disconnect(uid);
-		}
-	});
+	return Connection(this->_private, this->_private->connect(obj, func));
 }
 
 template <typename T>
@@ -130,6 +121,14 @@ PropertyImpl<T>::disconnect(std::uint32_t uid) {
 	this->_observers.erase(uid);
 }
 
+template <typename T>
+void
+PropertyImpl<T>::disconnect(std::span<const std::uint32_t> uids) {
+	for (std::uint32_t uid : uids) {
+		this->_observers.erase(uid);
+	}
+}
+
 template <typename T>
 const T&
 PropertyImpl<T>::get() const {
@@ -4,16 +4,19 @@
 #include "../Signal.hpp"
 
 #include <cstdint>
+#include <span>
 #include <unordered_map>
 
 namespace Signal {
 
 template <typename... T>
-class SignalImpl {
+class SignalImpl : public SlotTable {
 	public:
 	using Observer = std::function<void(const T&...)>;
 
-	SignalImpl()                  = default;
+	SignalImpl()
+	  : _uid(0)
+	  , _observers() {}
 	~SignalImpl()                 = default;
 	SignalImpl(const SignalImpl&) = delete;             // no cpyable
 	SignalImpl& operator=(const SignalImpl&) = delete;  // no cpy op
@@ -24,7 +27,8 @@ class SignalImpl {
 	std::uint32_t connect(ObserverType&& observer);
 	template <class U>
 	std::uint32_t connect(U* obj, void (U::*func)(const T&...));
-	void disconnect(std::uint32_t uid);
+	void disconnect(std::uint32_t uid) override;
+	void disconnect(std::span<const std::uint32_t> uids) override;
 
 	template <class... CallArgs>
 	void emit(CallArgs&&... args) const;
@@ -48,35 +52,46 @@ template <typename... T>
 template <class ObserverType>
 Connection
 Signal<T...>::connect(ObserverType&& observer) {
-	std::uint32_t uid                  = this->_private->connect(observer);
-	std::weak_ptr<SignalImpl<T...>> wp = this->_private;
-	return Connection([=]() {
-		auto sp = wp.lock();
-		if (sp != nullptr) {
-			sp->disconnect(uid);
-		}
-	});
+	return Connection(this->_private, this->_private->connect(observer));
 }
 
 template <typename... T>
 template <class U>
 Connection
 Signal<T...>::connect(U* obj, void (U::*func)(const T&...)) {
-	std::uint32_t uid                  = this->_private->connect(obj, func);
-	std::weak_ptr<SignalImpl<T...>> wp = this->_private;
-	return Connection([=]() {
-		auto sp = wp.lock();
-		if (sp != nullptr) {
-			sp->disconnect(uid);
-		}
+	return Connection(this->_private, this->_private->connect(obj, func));
+}
+
+template <typename... T>
+template <class ObserverType>
+Connection
+Signal<T...>::connect(EventLoop& loop, ObserverType&& observer) {
+	// The queued call only keeps a weak reference on the observer, so it is
+	// dropped if the connection is closed in the meantime.
+	auto slot = std::make_shared<Observer>(std::forward<ObserverType>(observer));
+	return connect([&loop, slot](const T&... args) {
+		std::weak_ptr<Observer> wp = slot;
+		loop.post([wp, args...]() {
+			auto sp = wp.lock();
+			if (sp != nullptr) {
+				(*sp)(args...);
+			}
+		});
 	});
 }
 
+template <typename... T>
+template <class U>
+Connection
+Signal<T...>::connect(EventLoop& loop, U* obj, void (U::*func)(const T&...)) {
+	return connect(loop, [=](const T&... args) { (obj->*func)(args...); });
+}
+
 template <typename... T>
 template <class... CallArgs>
 void
 Signal<T...>::emit(CallArgs&&... args) const {
-	this->_private->emit(args...);
+	this->_private->emit(std::forward<CallArgs>(args)...);
 }
 
 template <typename... T>
@@ -116,6 +131,14 @@ SignalImpl<T...>::disconnect(std::uint32_t uid) {
 	this->_observers.erase(uid);
 }
 
+template <typename... T>
+void
+SignalImpl<T...>::disconnect(std::span<const std::uint32_t> uids) {
+	for (std::uint32_t uid : uids) {
+		this->_observers.erase(uid);
+	}
+}
+
 template <typename... T>
 template <class... CallArgs>
 void
@@ -0,0 +1,34 @@
+//! @file
+#pragma once
+
+#include "../StaticSignal.hpp"
+
+#include <functional>
+#include <utility>
+
+namespace Signal {
+
+template <typename... T>
+template <auto... Slots>
+template <class... CallArgs>
+inline void
+StaticSignal<T...>::with<Slots...>::emit(CallArgs&&... args) {
+	if constexpr (sizeof...(Slots) != 0) {
+		_emit<Slots...>(std::forward<CallArgs>(args)...);
+	}
+}
+
+template <typename... T>
+template <auto... Slots>
+template <auto First, auto... Rest, class... CallArgs>
+inline void
+StaticSignal<T...>::with<Slots...>::_emit(CallArgs&&... args) {
+	if constexpr (sizeof...(Rest) == 0) {
+		std::invoke(First, std::forward<CallArgs>(args)...);
+	} else {
+		// Can't forward the same arguments twice.
+		std::invoke(First, std::as_const(args)...);
+		_emit<Rest...>(std::forward<CallArgs>(args)...);
+	}
+}
+} // namespace Signal
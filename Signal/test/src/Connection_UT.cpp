@@ -0,0 +1,108 @@
+#include <catch2/catch_all.hpp>
+#include <Signal/Connection.hpp>
+#include <Signal/Property.hpp>
+#include <Signal/Signal.hpp>
+
+namespace {
+int g_value;
+
+TEST_CASE("Connection: handle", "[Connection]") {
+	SECTION("Default Connection is closed") {
+		Signal::Connection hdl;
+		REQUIRE_FALSE(hdl.connected());
+		REQUIRE_NOTHROW(hdl.disconnect());
+	}
+	SECTION("Disconnect") {
+		Signal::Signal<int> sig;
+		Signal::Connection hdl = sig.connect([](int val) { g_value = val; });
+		REQUIRE(hdl.connected());
+		REQUIRE(sig.size() == 1);
+		REQUIRE_NOTHROW(hdl.disconnect());
+		REQUIRE_FALSE(hdl.connected());
+		REQUIRE(sig.empty());
+		REQUIRE_NOTHROW(hdl.disconnect());
+	}
+	SECTION("Disconnect a const connection") {
+		Signal::Property<int> prop;
+		const Signal::Connection hdl = prop.connect([](int val) { g_value = val; });
+		REQUIRE(prop.size() == 1);
+		REQUIRE_NOTHROW(hdl.disconnect());
+		REQUIRE_FALSE(hdl.connected());
+		REQUIRE(prop.empty());
+	}
+	SECTION("Move") {
+		Signal::Property<int> prop;
+		Signal::Connection hdl = prop.connect([](int val) { g_value = val; });
+		Signal::Connection other(std::move(hdl));
+		REQUIRE_FALSE(hdl.connected());
+		REQUIRE(other.connected());
+		REQUIRE(prop.size() == 1);
+		Signal::Connection last = prop.connect([](int val) { g_value = val; });
+		REQUIRE(prop.size() == 2);
+		last = std::move(other);
+		REQUIRE(prop.size() == 1);
+		REQUIRE(last.connected());
+	}
+	SECTION("Signal destroyed first") {
+		Signal::Connection hdl;
+		{
+			Signal::Signal<int> sig;
+			hdl = sig.connect([](int val) { g_value = val; });
+			REQUIRE(hdl.connected());
+		}
+		REQUIRE_FALSE(hdl.connected());
+		REQUIRE_NOTHROW(hdl.disconnect());
+	}
+}
+
+TEST_CASE("Connection: ScopedConnectionGroup", "[Connection]") {
+	g_value = 0;
+	Signal::Signal<int> sig;
+	Signal::Property<int> prop;
+
+	SECTION("Scope exit closes all connections") {
+		{
+			Signal::ScopedConnectionGroup group;
+			group.reserve(2000);
+			for (int i = 0; i < 1000; ++i) {
+				group += sig.connect([](int val) { g_value += val; });
+			}
+			for (int i = 0; i < 1000; ++i) {
+				group.add(prop.connect([](int val) { g_value += val; }));
+			}
+			REQUIRE(group.size() == 2000);
+			REQUIRE(sig.size() == 1000);
+			REQUIRE(prop.size() == 1000);
+			REQUIRE_NOTHROW(sig.emit(1));
+			CHECK(g_value == 1000);
+		}
+		REQUIRE(sig.empty());
+		REQUIRE(prop.empty());
+	}
+	SECTION("Interleaved connections") {
+		Signal::ScopedConnectionGroup group;
+		for (int i = 0; i < 10; ++i) {
+			group += sig.connect([](int val) { g_value += val; });
+			group += prop.connect([](int val) { g_value += val; });
+		}
+		Signal::Connection outsider = sig.connect([](int val) { g_value += val; });
+		REQUIRE(sig.size() == 11);
+		REQUIRE_NOTHROW(group.disconnect());
+		REQUIRE(group.empty());
+		REQUIRE(sig.size() == 1);
+		REQUIRE(prop.empty());
+		REQUIRE(outsider.connected());
+	}
+	SECTION("Signal destroyed first") {
+		Signal::ScopedConnectionGroup group;
+		{
+			Signal::Signal<int> tmp;
+			group += tmp.connect([](int val) { g_value += val; });
+			group += sig.connect([](int val) { g_value += val; });
+		}
+		REQUIRE(sig.size() == 1);
+		REQUIRE_NOTHROW(group.disconnect());
+		REQUIRE(sig.empty());
+	}
+}
+} // namespace
@@ -0,0 +1,108 @@
+#include <catch2/catch_all.hpp>
+#include <Signal/EventLoop.hpp>
+#include <Signal/Signal.hpp>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST_CASE("EventLoop: post and process", "[EventLoop]") {
+	Signal::EventLoop loop;
+	REQUIRE(loop.depth() == 0);
+	REQUIRE(loop.processEvents() == 0);
+
+	std::vector<int> values;
+	for (int i = 0; i < 5; ++i) {
+		loop.post([&values, i]() { values.push_back(i); });
+	}
+	REQUIRE(loop.depth() == 5);
+	CHECK(values.empty());
+
+	SECTION("Drain all") {
+		REQUIRE(loop.processEvents() == 5);
+		CHECK(values == std::vector<int>({0, 1, 2, 3, 4}));
+		CHECK(loop.depth() == 0);
+	}
+	SECTION("Drain by batch") {
+		loop.setMaxBatchSize(2);
+		REQUIRE(loop.maxBatchSize() == 2);
+		REQUIRE(loop.processEvents() == 2);
+		CHECK(values == std::vector<int>({0, 1}));
+		CHECK(loop.depth() == 3);
+		REQUIRE(loop.processEvents(0) == 3);
+		CHECK(values == std::vector<int>({0, 1, 2, 3, 4}));
+	}
+
+	Signal::EventLoop::Stats stats = loop.stats();
+	CHECK(stats.depth == 0);
+	CHECK(stats.posted == 5);
+	CHECK(stats.processed == 5);
+	CHECK(stats.maxLatency <= stats.totalLatency);
+	loop.resetStats();
+	CHECK(loop.stats().processed == 0);
+}
+
+TEST_CASE("EventLoop: queued Signal connection", "[EventLoop]") {
+	Signal::EventLoop loop;
+	Signal::Signal<int> sig;
+	int value = 0;
+
+	SECTION("Observer is called on processEvents") {
+		auto c = sig.connect(loop, [&](int val) { value = val; });
+		REQUIRE(sig.size() == 1);
+		REQUIRE_NOTHROW(sig.emit(7));
+		CHECK(value == 0);
+		CHECK(loop.depth() == 1);
+		REQUIRE(loop.processEvents() == 1);
+		CHECK(value == 7);
+	}
+	SECTION("Pending call is dropped on disconnection") {
+		{
+			auto c = sig.connect(loop, [&](int val) { value = val; });
+			REQUIRE_NOTHROW(sig.emit(3));
+		}
+		REQUIRE(sig.empty());
+		REQUIRE(loop.processEvents() == 1);
+		CHECK(value == 0);
+	}
+}
+
+struct Counter {
+	void handler(const int& val) { sum += val; }
+	int sum = 0;
+};
+
+TEST_CASE("EventLoop: cross-thread delivery", "[EventLoop]") {
+	Signal::EventLoop loop(16);
+	Signal::Signal<int> sig;
+	Counter counter;
+	std::thread::id loopThreadId;
+	std::thread::id observerThreadId;
+
+	auto c0 = sig.connect(loop, &counter, &Counter::handler);
+	auto c1 = sig.connect(loop, [&](int) { observerThreadId = std::this_thread::get_id(); });
+
+	std::thread consumer([&]() {
+		loopThreadId = std::this_thread::get_id();
+		loop.exec();
+	});
+	std::vector<std::thread> producers;
+	for (int i = 0; i < 4; ++i) {
+		producers.emplace_back([&sig]() {
+			for (int j = 0; j < 1000; ++j) {
+				sig.emit(1);
+			}
+		});
+	}
+	for (auto& producer : producers) {
+		producer.join();
+	}
+	loop.quit();
+	consumer.join();
+
+	CHECK(counter.sum == 4000);
+	CHECK(observerThreadId == loopThreadId);
+	CHECK(loop.depth() == 0);
+	CHECK(loop.stats().processed == 8001);
+}
+} // namespace
@@ -0,0 +1,71 @@
+#include <catch2/catch_all.hpp>
+#include <Signal/StaticSignal.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::string> g_calls;
+
+void
+first(const int& val) {
+	g_calls.push_back("first:" + std::to_string(val));
+}
+
+void
+second(const int& val) {
+	g_calls.push_back("second:" + std::to_string(val));
+}
+
+TEST_CASE("StaticSignal: emit", "[StaticSignal]") {
+	g_calls.clear();
+	SECTION("No observer") {
+		using Sig = Signal::StaticSignal<int>::with<>;
+		REQUIRE(Sig::empty());
+		REQUIRE(Sig::size() == 0);
+		REQUIRE_NOTHROW(Sig::emit(1));
+		CHECK(g_calls.empty());
+	}
+	SECTION("Observers are called in order") {
+		using Sig = Signal::StaticSignal<int>::with<&first, &second>;
+		REQUIRE(Sig::size() == 2);
+		REQUIRE_NOTHROW(Sig::emit(3));
+		CHECK(g_calls == std::vector<std::string>({"first:3", "second:3"}));
+	}
+}
+
+struct Tracker {
+	Tracker() = default;
+	Tracker(const Tracker&) { ++copies; }
+	Tracker(Tracker&&) noexcept { ++moves; }
+	static int copies;
+	static int moves;
+};
+int Tracker::copies = 0;
+int Tracker::moves  = 0;
+
+void
+peek(const Tracker&) {}
+void
+sink(Tracker) {}
+
+TEST_CASE("StaticSignal: perfect forwarding", "[StaticSignal]") {
+	Tracker::copies = 0;
+	Tracker::moves  = 0;
+	SECTION("Single observer") {
+		Signal::StaticSignal<Tracker>::with<&sink>::emit(Tracker());
+		CHECK(Tracker::copies == 0);
+		CHECK(Tracker::moves == 1);
+	}
+	SECTION("Only the last observer receives the rvalue") {
+		Signal::StaticSignal<Tracker>::with<&peek, &sink>::emit(Tracker());
+		CHECK(Tracker::copies == 0);
+		CHECK(Tracker::moves == 1);
+	}
+	SECTION("Lvalue are not moved") {
+		Tracker tracker;
+		Signal::StaticSignal<Tracker>::with<&peek, &sink>::emit(tracker);
+		CHECK(Tracker::copies == 1);
+		CHECK(Tracker::moves == 0);
+	}
+}
+} // namespace
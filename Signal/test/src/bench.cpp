@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include <Signal/Signal.hpp>
+#include <Signal/StaticSignal.hpp>
 #include <chrono>
 
 using namespace std::chrono;
@@ -117,7 +118,7 @@ TEST_CASE("Bench Signal: Member function connection", "[Bench]") {
 				sig.emit(1);
 			}
 			auto after = system_clock::now();
-			CHECK(g_value == LOOP);
+			CHECK(fooPtr->value == LOOP);
 			double call =
 			  LOOP * 1000. / double(duration_cast<milliseconds>(after - before).count());
 			WARN(call << "calls/s");
@@ -134,7 +135,7 @@ TEST_CASE("Bench Signal: Member function connection", "[Bench]") {
 				sig.emit(1);
 			}
 			auto after = system_clock::now();
-			CHECK(g_value == LOOP);
+			CHECK(fooPtr->value == LOOP);
 			double call =
 			  LOOP * 1000. / double(duration_cast<milliseconds>(after - before).count());
 			WARN(call << "calls/s");
@@ -152,7 +153,7 @@ TEST_CASE("Bench Signal: Member function connection", "[Bench]") {
 				sig.emit(1);
 			}
 			auto after = system_clock::now();
-			CHECK(g_value == LOOP);
+			CHECK(fooPtr->value == LOOP);
 			double call =
 			  LOOP * 1000. / double(duration_cast<milliseconds>(after - before).count());
 			WARN(call << "calls/s");
@@ -160,4 +161,46 @@ TEST_CASE("Bench Signal: Member function connection", "[Bench]") {
 		REQUIRE(sig.size() == 0);
 	}
 }
+
+TEST_CASE("Bench Signal: static vs dynamic vs raw call", "[Bench]") {
+	// Use nanoseconds since the raw and static loops may run in less than 1ms.
+	auto callsPerSecond = [](auto before, auto after) {
+		const double ns = double(duration_cast<nanoseconds>(after - before).count());
+		return LOOP * 1e9 / (ns > 0. ? ns : 1.);
+	};
+
+	SECTION("Raw function call") {
+		g_value     = 0;
+		auto before = steady_clock::now();
+		for (std::size_t loop = 0; loop < LOOP; ++loop) {
+			freeFunction(1);
+		}
+		auto after = steady_clock::now();
+		CHECK(g_value == LOOP);
+		WARN("raw: " << callsPerSecond(before, after) << "calls/s");
+	}
+	SECTION("StaticSignal") {
+		using Sig   = Signal::StaticSignal<int>::with<&freeFunction>;
+		g_value     = 0;
+		auto before = steady_clock::now();
+		for (std::size_t loop = 0; loop < LOOP; ++loop) {
+			Sig::emit(1);
+		}
+		auto after = steady_clock::now();
+		CHECK(g_value == LOOP);
+		WARN("static: " << callsPerSecond(before, after) << "calls/s");
+	}
+	SECTION("Signal") {
+		Signal::Signal<int> sig;
+		auto c      = sig.connect(&freeFunction);
+		g_value     = 0;
+		auto before = steady_clock::now();
+		for (std::size_t loop = 0; loop < LOOP; ++loop) {
+			sig.emit(1);
+		}
+		auto after = steady_clock::now();
+		CHECK(g_value == LOOP);
+		WARN("dynamic: " << callsPerSecond(before, after) << "calls/s");
+	}
+}
 } // namespace